@@ -0,0 +1,53 @@
+#ifndef BenchCorpora_h
+#define BenchCorpora_h
+
+// Fixed 9x9 puzzle sets for the benchmark suite, one 81-character line each.
+// Every puzzle has exactly one solution.
+namespace sudoku::bench {
+
+// Solvable with naked and hidden singles: Project Euler 96 grids and puzzles
+// from `sudoku --difficulty easy --seed 2014`.
+inline const char* const kEasyCorpus[] = {
+    "003020600900305001001806400008102900700000008006708200002609500800203009005010300",
+    "200080300060070084030500209000105408000000000402706000301007040720040060004010003",
+    "000000907000420180000705026100904000050000040000507009920108000034059000507000000",
+    "030050040008010500460000012070502080000603000040109030250000098001020600080060020",
+    "020810740700003100090002805009040087400208003160030200302700060005600008076051090",
+    "..8..76..5.........9.6..8.....2...6.7.5....14...3..9......39......41..7..49..8...",
+    ".2.4.7..5....2.46.........16.8......2....83.73...92....8..762.9...8.....71..43...",
+    "..8.6.23......2.75..7......3.....9216...........9.56.3.3..98..2.1.7......8..4.5..",
+    "35...428..2......5..6..8....6...7.....5...1..91...5.4.4.........8..........6214..",
+    "9.64..3....8..6..5.53.97.4...58......6..7.8.....62....1.2....9..3....5.........1.",
+    ".19......63.5....2....7..8.8.1.....4..6.541....3.......8.7..2......923......1.59.",
+    "2....47..7.5.8...1.987....6..6...2.7...6.8...952.7......4.......8.5..1..5.9813...",
+    "...59.7.....182........4.96.5.....1.29.....8.........7..7...54.4....13..6.5..8...",
+};
+
+// The first puzzles of Norvig's top95 list and minimal puzzles from
+// `sudoku --difficulty extreme --seed 2014`.
+inline const char* const kHardCorpus[] = {
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+    "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+    "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+    "48.3............71.2.......7.5....6....2..8.............1.76...3.....4......5....",
+    "....14....3....2...7..........9...3.6.1.............8.2.....1.4....5.6.....7.8...",
+    "..8..76..5.........9.6..8.....2...6.7.5....14...3..9......39.......1..7..49..8...",
+    "..6.1.....9.7...645.79......6...9.7......5..2..3..2.1.....4.....1.5....64....1.93",
+    "..8.6.23......2.75..7........5.....16...3......19..6.3.3..98..2.1.7......8..4.5..",
+    "5....93.4....2.....3..18..9..7...8..4.5.3..1...8.71....19.....5......17........4.",
+    "827............35.....8.47..5..1...43..8....9...7.4..57....5...268..7.9..1.......",
+};
+
+// Puzzles built to defeat human techniques or naive backtracking: Easter
+// Monster, AI Escargot, Inkala's 2012 puzzle and the Wikipedia example whose
+// solution starts 987654321, the worst order for a backtracker counting up.
+inline const char* const kPathologicalCorpus[] = {
+    "1.......2.9.4...5...6...7...5.9.3.......7.......85..4.7.....6...3...9.8...2.....1",
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+    "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..",
+    "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9",
+};
+
+} // namespace sudoku::bench
+
+#endif /* BenchCorpora_h */
@@ -1,27 +1,521 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "BatchSolver.h"
+#include "BenchCorpora.h"
 #include "Board.h"
 #include "ParseUtils.h"
+#include "PlaySession.h"
+#include "SolutionSampler.h"
 
 using namespace sudoku;
+using namespace sudoku::bench;
 
 namespace {
 
+struct Options
+{
+    unsigned int iterations = 20;
+    std::string filter;
+    std::optional<std::string> jsonPath;
+    std::optional<std::string> baselinePath;
+    unsigned int threshold = 10;
+    bool searchStats = false;
+};
+
+struct Corpus
+{
+    const char* name;
+    std::vector<Grid> puzzles;
+};
+
+struct BackendInfo
+{
+    SolverBackend backend;
+    const char* name;
+};
+
+const BackendInfo kBackends[] = {
+    {SolverBackend::Mrv, "mrv"},
+    {SolverBackend::Dlx, "dlx"},
+    {SolverBackend::Bitboard, "bitboard"},
+};
+
+struct Summary
+{
+    std::string name;
+    std::size_t samples = 0;
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double p999Us = 0.0;
+    double opsPerSec = 0.0;
+    // Search nodes per call; uniqueness checks for generatePuzzle.
+    double workPerOp = 0.0;
+};
+
+// Search statistics of one corpus puzzle solved on one backend.
+struct PuzzleStats
+{
+    std::string corpus;
+    std::size_t puzzle = 0;
+    const char* backend = "";
+    SearchStats stats;
+};
+
+// The two figures a run is compared on.
+struct BaselineEntry
+{
+    double p50Us = 0.0;
+    double opsPerSec = 0.0;
+};
+
+template <std::size_t N>
+Corpus makeCorpus(const char* name, const char* const (&lines)[N])
+{
+    Corpus corpus{name, {}};
+    Board parser;
+    for(const char* line : lines)
+    {
+        if(parser.loadFromString(line))
+            corpus.puzzles.push_back(parser.getBoardData());
+    }
+    return corpus;
+}
+
+// Nearest-rank percentile of sorted samples.
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+    if(sorted.empty())
+        return 0.0;
+    const double rank = std::ceil(fraction * static_cast<double>(sorted.size()));
+    const std::size_t index = static_cast<std::size_t>(std::max(rank, 1.0)) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+class Suite
+{
+public:
+    explicit Suite(const Options& options) : _options(options) {}
+
+    // Times samples calls of operation with one clock reading around each.
+    // The operation returns the work it did (see Summary::workPerOp). Boards
+    // and engines are built and seeded by the caller, outside the samples.
+    void run(const std::string& name, std::size_t samples, const std::function<uint64_t(std::size_t)>& operation)
+    {
+        if(!_options.filter.empty() && name.find(_options.filter) == std::string::npos)
+            return;
+
+        // A few untimed calls warm the caches and lazily built tables.
+        for(std::size_t sample = 0; sample < std::min<std::size_t>(samples, 4); ++sample)
+            operation(sample);
+
+        std::vector<double> times;
+        times.reserve(samples);
+        uint64_t work = 0;
+        const auto runStart = std::chrono::steady_clock::now();
+        for(std::size_t sample = 0; sample < samples; ++sample)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            work += operation(sample);
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            times.push_back(elapsed.count());
+        }
+        std::chrono::duration<double> total = std::chrono::steady_clock::now() - runStart;
+
+        Summary summary;
+        summary.name = name;
+        summary.samples = samples;
+        double sum = 0.0;
+        for(double time : times)
+            sum += time;
+        std::sort(times.begin(), times.end());
+        summary.meanUs = samples == 0 ? 0.0 : sum / static_cast<double>(samples);
+        summary.p50Us = percentile(times, 0.5);
+        summary.p99Us = percentile(times, 0.99);
+        summary.p999Us = percentile(times, 0.999);
+        summary.opsPerSec = total.count() > 0.0 ? static_cast<double>(samples) / total.count() : 0.0;
+        summary.workPerOp = samples == 0 ? 0.0 : static_cast<double>(work) / static_cast<double>(samples);
+        printRow(summary);
+        _results.push_back(summary);
+    }
+
+    const std::vector<Summary>& results() const { return _results; }
+
+    static void printHeader()
+    {
+        std::cout << std::left << std::setw(32) << "Benchmark" << std::right << std::setw(9) << "Samples"
+                  << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "p99.9 us"
+                  << std::setw(12) << "ops/s" << std::setw(12) << "work/op" << "\n";
+        std::cout << std::string(101, '-') << "\n";
+    }
+
+private:
+    static void printRow(const Summary& summary)
+    {
+        std::cout << std::left << std::setw(32) << summary.name << std::right << std::setw(9) << summary.samples
+                  << std::fixed << std::setprecision(2) << std::setw(12) << summary.p50Us << std::setw(12)
+                  << summary.p99Us << std::setw(12) << summary.p999Us << std::setprecision(0) << std::setw(12)
+                  << summary.opsPerSec << std::setprecision(1) << std::setw(12) << summary.workPerOp << "\n";
+    }
+
+    const Options& _options;
+    std::vector<Summary> _results;
+};
+
+void runSolveAndCount(Suite& suite, const std::vector<Corpus>& corpora, unsigned int iterations)
+{
+    Board board(1);
+    for(const Corpus& corpus : corpora)
+    {
+        const std::size_t samples = corpus.puzzles.size() * iterations;
+        for(const BackendInfo& info : kBackends)
+        {
+            suite.run(std::string("solve/") + corpus.name + "/" + info.name, samples, [&](std::size_t sample) {
+                board.loadFromData(corpus.puzzles[sample % corpus.puzzles.size()]);
+                board.solve(info.backend);
+                return board.getLastSearchNodes();
+            });
+        }
+        for(const BackendInfo& info : kBackends)
+        {
+            suite.run(std::string("count2/") + corpus.name + "/" + info.name, samples, [&](std::size_t sample) {
+                board.loadFromData(corpus.puzzles[sample % corpus.puzzles.size()]);
+                board.countSolutions(2, info.backend);
+                return board.getLastSearchNodes();
+            });
+        }
+    }
+
+    // MRV without naked/hidden single propagation, to show what it saves.
+    board.setPropagationEnabled(false);
+    const Corpus& hard = corpora[1];
+    suite.run("count2/hard/mrv-plain", hard.puzzles.size() * iterations, [&](std::size_t sample) {
+        board.loadFromData(hard.puzzles[sample % hard.puzzles.size()]);
+        board.countSolutions(2);
+        return board.getLastSearchNodes();
+    });
+    board.setPropagationEnabled(true);
+}
+
+// Puzzles per sample of the batch benchmarks.
+constexpr std::size_t kBatchPuzzles = 256;
+// Grids per sample of the sampleSolution benchmarks.
+constexpr std::size_t kSampledGrids = 4096;
+// Keystrokes per sample of the play benchmark.
+constexpr std::size_t kKeystrokes = 4096;
+
+// Solves kBatchPuzzles corpus puzzles per sample, one at a time on the scalar
+// engines and kLanes at a time on the batch solver, so ops/s compare directly
+// and puzzles/s is ops/s times kBatchPuzzles.
+void runBatch(Suite& suite, const std::vector<Corpus>& corpora, unsigned int iterations)
+{
+    Board board(1);
+    BatchSolver solver;
+    std::vector<Grid> batch(kBatchPuzzles);
+    std::vector<BatchOutcome> outcomes(kBatchPuzzles);
+    for(const Corpus& corpus : corpora)
+    {
+        for(std::size_t index = 0; index < kBatchPuzzles; ++index)
+            batch[index] = corpus.puzzles[index % corpus.puzzles.size()];
+
+        for(const BackendInfo& info : {kBackends[0], kBackends[2]})
+        {
+            suite.run(std::string("batch/") + corpus.name + "/" + info.name, iterations, [&](std::size_t) {
+                uint64_t nodes = 0;
+                for(const Grid& puzzle : batch)
+                {
+                    board.loadFromData(puzzle);
+                    board.solve(info.backend);
+                    nodes += board.getLastSearchNodes();
+                }
+                return nodes;
+            });
+        }
+        suite.run(std::string("batch/") + corpus.name + "/lanes", iterations, [&](std::size_t) {
+            solver.solve(batch, outcomes);
+            return solver.nodes();
+        });
+    }
+}
+
+void runGenerate(Suite& suite, unsigned int iterations)
+{
+    for(const BackendInfo& info : kBackends)
+    {
+        Board board(7);
+        suite.run(std::string("generateSolution/") + info.name, iterations * 10, [&](std::size_t) {
+            board.generateSolution(info.backend);
+            return board.getLastSearchNodes();
+        });
+    }
+
+    // kSampledGrids grids per sample, so grids/s is ops/s times kSampledGrids;
+    // the work column counts the seeds searched for the sample.
+    for(uint64_t freshInterval : {uint64_t{0}, uint64_t{1024}})
+    {
+        SolutionSampler::Options options;
+        options.freshInterval = freshInterval;
+        SolutionSampler sampler(7, options);
+        std::vector<Grid> grids(kSampledGrids);
+        suite.run("sampleSolution/fresh" + std::to_string(freshInterval), iterations * 10, [&](std::size_t) {
+            const uint64_t searched = sampler.searchedSeeds();
+            sampler.fill(grids);
+            return sampler.searchedSeeds() - searched;
+        });
+    }
+
+    for(unsigned int clues : {22u, 26u, 30u, 35u})
+    {
+        Board board(11);
+        suite.run("generatePuzzle/" + std::to_string(clues), iterations, [&](std::size_t) {
+            while(!board.generatePuzzle(clues))
+                ;
+            return board.getLastGenerationStats().uniquenessChecks;
+        });
+    }
+
+    for(Difficulty tier : {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard})
+    {
+        Board board(13);
+        suite.run(std::string("generatePuzzle/") + difficultyName(tier), iterations, [&](std::size_t) {
+            while(!board.generatePuzzle(tier))
+                ;
+            return board.getLastGenerationStats().uniquenessChecks;
+        });
+    }
+}
+
+// Replays kKeystrokes random keystrokes on a PlaySession per sample: digits
+// (0 erases) into random cells, every fourth keystroke an undo and every
+// eighth a redo, each followed by the conflict check a front end makes to
+// colour the cell. Keystrokes/s is ops/s times kKeystrokes; the work column
+// counts the keystrokes that left their cell in conflict.
+void runPlay(Suite& suite, const std::vector<Corpus>& corpora, unsigned int iterations)
+{
+    PlaySession session;
+    session.load(corpora[0].puzzles[0]);
+    Xoshiro256PlusPlus rng(5);
+    std::vector<std::pair<uint8_t, uint8_t>> script(kKeystrokes);
+    for(auto& [cell, digit] : script)
+    {
+        cell = static_cast<uint8_t>(uniformBelow(rng, 81));
+        digit = static_cast<uint8_t>(uniformBelow(rng, 10));
+    }
+
+    suite.run("play/keystrokes", iterations * 10, [&](std::size_t) {
+        uint64_t conflicts = 0;
+        for(std::size_t index = 0; index < script.size(); ++index)
+        {
+            const auto [cell, digit] = script[index];
+            if(index % 8 == 7)
+                session.redo();
+            else if(index % 4 == 3)
+                session.undo();
+            else
+                session.place(cell, digit);
+            conflicts += session.hasConflict(cell) ? 1 : 0;
+        }
+        return conflicts;
+    });
+}
+
+void runGrade(Suite& suite, const std::vector<Corpus>& corpora, unsigned int iterations)
+{
+    Grader grader;
+    for(const Corpus& corpus : corpora)
+    {
+        suite.run(std::string("grade/") + corpus.name, corpus.puzzles.size() * iterations, [&](std::size_t sample) {
+            grader.grade(corpus.puzzles[sample % corpus.puzzles.size()]);
+            return uint64_t{0};
+        });
+    }
+}
+
+// Solves every corpus puzzle once per backend with statistics collection on.
+// Runs after the timed benchmarks, so collection never affects their figures.
+std::vector<PuzzleStats> collectSearchStats(const std::vector<Corpus>& corpora)
+{
+    std::vector<PuzzleStats> collected;
+    Board board(1);
+    board.setSearchStatsEnabled(true);
+    for(const Corpus& corpus : corpora)
+    {
+        for(std::size_t puzzle = 0; puzzle < corpus.puzzles.size(); ++puzzle)
+        {
+            for(const BackendInfo& info : kBackends)
+            {
+                board.loadFromData(corpus.puzzles[puzzle]);
+                board.solve(info.backend);
+                collected.push_back({corpus.name, puzzle + 1, info.name, board.getLastSearchStats()});
+            }
+        }
+    }
+    return collected;
+}
+
+void printSearchStats(const std::vector<PuzzleStats>& collected)
+{
+    std::cout << "\nSearch statistics for solve\n\n";
+    std::cout << std::left << std::setw(20) << "Puzzle" << std::setw(10) << "Backend" << std::right << std::setw(10)
+              << "Nodes" << std::setw(12) << "Backtracks" << std::setw(14) << "Propagations" << std::setw(8)
+              << "Depth" << std::setw(10) << "Scanned" << std::setw(10) << "Branch" << "\n";
+    std::cout << std::string(94, '-') << "\n";
+    for(const PuzzleStats& entry : collected)
+    {
+        const SearchStats& stats = entry.stats;
+        std::cout << std::left << std::setw(20) << (entry.corpus + " #" + std::to_string(entry.puzzle))
+                  << std::setw(10) << entry.backend << std::right << std::setw(10) << stats.nodes << std::setw(12)
+                  << stats.backtracks << std::setw(14) << stats.propagations << std::setw(8) << stats.maxDepth
+                  << std::setw(10) << stats.scannedCells << std::fixed << std::setprecision(2) << std::setw(10)
+                  << stats.averageBranching() << "\n";
+    }
+}
+
+bool writeJson(const std::string& path, const Options& options, const std::vector<Summary>& results,
+               const std::vector<PuzzleStats>& collected)
+{
+    std::ofstream file(path);
+    if(!file)
+        return false;
+
+    // One result per line, which is also what readBaseline expects.
+    file << "{\n  \"benchmark\": \"sudokuBench\",\n  \"iterations\": " << options.iterations << ",\n  \"results\": [\n";
+    for(std::size_t index = 0; index < results.size(); ++index)
+    {
+        const Summary& summary = results[index];
+        file << std::fixed << std::setprecision(3) << "    {\"name\": \"" << summary.name << "\", \"samples\": "
+             << summary.samples << ", \"mean_us\": " << summary.meanUs << ", \"p50_us\": " << summary.p50Us
+             << ", \"p99_us\": " << summary.p99Us << ", \"p999_us\": " << summary.p999Us << ", \"ops_per_sec\": "
+             << summary.opsPerSec << ", \"work_per_op\": " << summary.workPerOp << "}"
+             << (index + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]";
+
+    if(!collected.empty())
+    {
+        file << ",\n  \"search\": [\n";
+        for(std::size_t index = 0; index < collected.size(); ++index)
+        {
+            const PuzzleStats& entry = collected[index];
+            const SearchStats& stats = entry.stats;
+            file << "    {\"corpus\": \"" << entry.corpus << "\", \"puzzle\": " << entry.puzzle << ", \"backend\": \""
+                 << entry.backend << "\", \"nodes\": " << stats.nodes << ", \"backtracks\": " << stats.backtracks
+                 << ", \"propagations\": " << stats.propagations << ", \"max_depth\": " << stats.maxDepth
+                 << ", \"scanned_cells\": " << stats.scannedCells << ", \"branching\": [";
+            for(unsigned int ways = 0; ways <= SearchStats::kMaxBranching; ++ways)
+                file << (ways == 0 ? "" : ", ") << stats.branching[ways];
+            file << "]}" << (index + 1 < collected.size() ? "," : "") << "\n";
+        }
+        file << "  ]";
+    }
+    file << "\n}\n";
+    return static_cast<bool>(file);
+}
+
+bool readNumber(const std::string& line, const std::string& key, double& value)
+{
+    const std::string pattern = "\"" + key + "\": ";
+    const std::size_t position = line.find(pattern);
+    if(position == std::string::npos)
+        return false;
+    value = std::strtod(line.c_str() + position + pattern.size(), nullptr);
+    return true;
+}
+
+// Reads the result lines of a file written by writeJson.
+bool readBaseline(const std::string& path, std::map<std::string, BaselineEntry>& baseline)
+{
+    std::ifstream file(path);
+    if(!file)
+        return false;
+
+    const std::string namePattern = "\"name\": \"";
+    std::string line;
+    while(std::getline(file, line))
+    {
+        const std::size_t nameStart = line.find(namePattern);
+        if(nameStart == std::string::npos)
+            continue;
+        const std::size_t first = nameStart + namePattern.size();
+        const std::size_t last = line.find('"', first);
+        if(last == std::string::npos)
+            continue;
+
+        BaselineEntry entry;
+        if(readNumber(line, "p50_us", entry.p50Us) && readNumber(line, "ops_per_sec", entry.opsPerSec))
+            baseline[line.substr(first, last - first)] = entry;
+    }
+    return true;
+}
+
+double percentChange(double before, double after)
+{
+    return before > 0.0 ? (after - before) * 100.0 / before : 0.0;
+}
+
+// Prints every result against the baseline and returns how many regressed:
+// p50 latency up, or throughput down, by more than threshold percent.
+unsigned int compareWithBaseline(const std::vector<Summary>& results,
+                                 const std::map<std::string, BaselineEntry>& baseline, unsigned int threshold)
+{
+    std::cout << "\nAgainst baseline (regression above " << threshold << "%)\n\n";
+    std::cout << std::left << std::setw(32) << "Benchmark" << std::right << std::setw(12) << "p50 before"
+              << std::setw(12) << "p50 now" << std::setw(10) << "p50 %" << std::setw(10) << "ops/s %" << "\n";
+    std::cout << std::string(76, '-') << "\n";
+
+    unsigned int regressions = 0;
+    for(const Summary& summary : results)
+    {
+        const auto found = baseline.find(summary.name);
+        if(found == baseline.end())
+        {
+            std::cout << std::left << std::setw(32) << summary.name << std::right << std::setw(12) << "-"
+                      << "  new\n";
+            continue;
+        }
+
+        const double latency = percentChange(found->second.p50Us, summary.p50Us);
+        const double throughput = percentChange(found->second.opsPerSec, summary.opsPerSec);
+        const bool regressed = latency > threshold || -throughput > threshold;
+        if(regressed)
+            ++regressions;
+        std::cout << std::left << std::setw(32) << summary.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << found->second.p50Us << std::setw(12) << summary.p50Us << std::showpos
+                  << std::setprecision(1) << std::setw(10) << latency << std::setw(10) << throughput
+                  << std::noshowpos << (regressed ? "  REGRESSION" : "") << "\n";
+    }
+    std::cout << "\n" << regressions << " regression(s)\n";
+    return regressions;
+}
+
 void printUsage(const char* program)
 {
-    std::cout << "Usage: " << program << " [--iterations N]\n";
-    std::cout << "  --iterations N  Number of runs (default 100)\n";
+    std::cout << "Usage: " << program << " [--iterations N] [--filter TEXT] [--json FILE] [--baseline FILE] [--threshold PCT] [--stats]\n";
+    std::cout << "  --iterations N   Passes over each corpus, and generate calls per benchmark (default 20)\n";
+    std::cout << "  --filter TEXT    Run only the benchmarks whose name contains TEXT\n";
+    std::cout << "  --json FILE      Write the results as JSON\n";
+    std::cout << "  --baseline FILE  Compare with the JSON of an earlier run; exit 2 on regressions\n";
+    std::cout << "  --threshold PCT  Slowdown that counts as a regression (default 10)\n";
+    std::cout << "  --stats          Also report search statistics for every corpus puzzle\n";
 }
 
 } // namespace
 
 int main(int argc, const char* argv[])
 {
-    unsigned int iterations = 100;
+    Options options;
 
     for(int i = 1; i < argc; ++i)
     {
@@ -34,12 +528,46 @@ int main(int argc, const char* argv[])
         if(arg == "--iterations" && i + 1 < argc)
         {
             unsigned int parsed = 0;
-            if(!parseUnsigned(argv[++i], parsed))
+            if(!parseUnsigned(argv[++i], parsed) || parsed == 0)
             {
                 std::cerr << "Invalid value for --iterations\n";
                 return 1;
             }
-            iterations = parsed;
+            options.iterations = parsed;
+            continue;
+        }
+        if(arg == "--threshold" && i + 1 < argc)
+        {
+            if(!parseUnsigned(argv[++i], options.threshold))
+            {
+                std::cerr << "Invalid value for --threshold\n";
+                return 1;
+            }
+            continue;
+        }
+        if(arg == "--stats")
+        {
+            if(!kSearchStatsEnabled)
+            {
+                std::cerr << "--stats needs a build with SUDOKU_SEARCH_STATS=ON\n";
+                return 1;
+            }
+            options.searchStats = true;
+            continue;
+        }
+        if(arg == "--filter" && i + 1 < argc)
+        {
+            options.filter = argv[++i];
+            continue;
+        }
+        if(arg == "--json" && i + 1 < argc)
+        {
+            options.jsonPath = argv[++i];
+            continue;
+        }
+        if(arg == "--baseline" && i + 1 < argc)
+        {
+            options.baselinePath = argv[++i];
             continue;
         }
 
@@ -48,40 +576,46 @@ int main(int argc, const char* argv[])
         return 1;
     }
 
-    std::vector<double> timesMs;
-    timesMs.reserve(iterations);
-
-    for(unsigned int i = 0; i < iterations; ++i)
+    // Read the baseline up front so a bad path fails before the long run.
+    std::map<std::string, BaselineEntry> baseline;
+    if(options.baselinePath.has_value() && !readBaseline(*options.baselinePath, baseline))
     {
-        Board board;
-        auto start = std::chrono::steady_clock::now();
-        board.generateSolution();
-        auto end = std::chrono::steady_clock::now();
-        std::chrono::duration<double, std::milli> elapsed = end - start;
-        timesMs.push_back(elapsed.count());
+        std::cerr << "Cannot read baseline " << *options.baselinePath << "\n";
+        return 1;
     }
 
-    double total = 0.0;
-    double min = timesMs.empty() ? 0.0 : timesMs.front();
-    double max = timesMs.empty() ? 0.0 : timesMs.front();
-    for(double value : timesMs)
+    const std::vector<Corpus> corpora = {
+        makeCorpus("easy", kEasyCorpus),
+        makeCorpus("hard", kHardCorpus),
+        makeCorpus("pathological", kPathologicalCorpus),
+    };
+
+    std::cout << "Sudoku Benchmark Suite\n";
+    std::cout << "Iterations: " << options.iterations << "\n\n";
+    Suite::printHeader();
+
+    Suite suite(options);
+    runSolveAndCount(suite, corpora, options.iterations);
+    runBatch(suite, corpora, options.iterations);
+    runGenerate(suite, options.iterations);
+    runGrade(suite, corpora, options.iterations);
+    runPlay(suite, corpora, options.iterations);
+
+    std::vector<PuzzleStats> collected;
+    if(options.searchStats)
     {
-        total += value;
-        if(value < min)
-            min = value;
-        if(value > max)
-            max = value;
+        collected = collectSearchStats(corpora);
+        printSearchStats(collected);
     }
 
-    double avg = iterations == 0 ? 0.0 : total / static_cast<double>(iterations);
+    if(options.jsonPath.has_value() && !writeJson(*options.jsonPath, options, suite.results(), collected))
+    {
+        std::cerr << "Cannot write " << *options.jsonPath << "\n";
+        return 1;
+    }
 
-    std::cout << "Sudoku Generation Benchmark\n";
-    std::cout << "Runs: " << iterations << "\n\n";
-    std::cout << std::left << std::setw(12) << "Metric" << std::right << std::setw(12) << "Milliseconds" << "\n";
-    std::cout << std::string(24, '-') << "\n";
-    std::cout << std::left << std::setw(12) << "Avg" << std::right << std::setw(12) << std::fixed << std::setprecision(3) << avg << "\n";
-    std::cout << std::left << std::setw(12) << "Min" << std::right << std::setw(12) << std::fixed << std::setprecision(3) << min << "\n";
-    std::cout << std::left << std::setw(12) << "Max" << std::right << std::setw(12) << std::fixed << std::setprecision(3) << max << "\n";
+    if(options.baselinePath.has_value() && compareWithBaseline(suite.results(), baseline, options.threshold) != 0)
+        return 2;
 
     return 0;
 }
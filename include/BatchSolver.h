@@ -0,0 +1,89 @@
+#ifndef BatchSolver_h
+#define BatchSolver_h
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Grid.h"
+#include "LaneVector.h"
+
+namespace sudoku {
+
+// Result of one puzzle of a batch.
+struct BatchOutcome
+{
+    // Solutions found, up to the limit of the call; 0 for an unsolvable or
+    // invalid puzzle.
+    uint32_t solutions = 0;
+    // The first solution found, when there is one.
+    Grid solution{};
+};
+
+// 9x9 solver that runs kLanes puzzles in lockstep, one per SIMD lane. Cell c
+// of every lane's puzzle sits in one LaneVector of candidate masks, so
+// naked and hidden singles, conflicts and the MRV branch cell are worked out
+// for all lanes with the same instructions. Only branching and backtracking
+// are per lane: each lane has its own stack of saved states, and a lane whose
+// puzzle is finished takes the next puzzle of the batch at once instead of
+// idling until the others are done.
+class BatchSolver
+{
+public:
+    static constexpr unsigned int kLanes = LaneVector::kLanes;
+    static constexpr unsigned int kDimension = 9;
+    static constexpr unsigned int kCells = 81;
+
+    BatchSolver();
+
+    // Searches each puzzle for up to limit solutions into the outcome of the
+    // same index; outcomes must be as long as puzzles. Limit 1 solves, limit
+    // 2 also tells unique puzzles from ambiguous ones.
+    void solve(std::span<const Grid> puzzles, std::span<BatchOutcome> outcomes, uint32_t limit = 1);
+
+    // Search nodes of the last call, summed over its puzzles.
+    uint64_t nodes() const { return _nodes; }
+
+private:
+    using LaneMasks = std::array<uint16_t, kLanes>;
+
+    // A branch point of one lane: its masks before the guess, the cell and
+    // the digits not tried yet.
+    struct Frame
+    {
+        std::array<uint16_t, kCells> masks;
+        uint8_t cell;
+        uint16_t remaining;
+    };
+
+    struct Lane
+    {
+        std::size_t puzzle = 0;
+        uint32_t solutions = 0;
+        unsigned int depth = 0;
+        bool active = false;
+    };
+
+    // Runs naked and hidden singles in every lane until no lane changes and
+    // returns the lanes that hit a contradiction.
+    uint32_t propagate();
+    // Picks the MRV cell of every lane; returns the lanes with no open cell.
+    uint32_t chooseCells(LaneMasks& cells) const;
+
+    bool start(unsigned int lane, const Grid& puzzle);
+    void branch(unsigned int lane, unsigned int cell);
+    // Resumes the lane's deepest untried alternative; false when none is left.
+    bool backtrack(unsigned int lane);
+    void record(unsigned int lane, Grid& solution) const;
+    void setCell(unsigned int lane, unsigned int cell, uint16_t mask) { _masks[cell][lane] = mask; }
+
+    std::array<LaneMasks, kCells> _masks{};
+    std::array<Lane, kLanes> _lanes{};
+    // kCells frames per lane: each branch fixes one more cell.
+    std::vector<Frame> _frames;
+    uint64_t _nodes = 0;
+};
+
+} // namespace sudoku
+
+#endif /* BatchSolver_h */
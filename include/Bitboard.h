@@ -0,0 +1,219 @@
+#ifndef Bitboard_h
+#define Bitboard_h
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#if !defined(SUDOKU_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SUDOKU_BITBOARD_SSE 1
+#include <emmintrin.h>
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#define SUDOKU_BITBOARD_SSE41 1
+#include <smmintrin.h>
+#endif
+#endif
+
+namespace sudoku {
+
+// Lane values of a Bitboard, used for constexpr tables.
+using BitboardLanes = std::array<uint32_t, 4>;
+
+// 81 cells of a 9x9 board in four 32-bit lanes. Lane b (0-2) holds band b, the
+// rows 3b to 3b+2, with cell (row, column) at bit (row % 3) * 9 + column; lane 3
+// stays zero. Each operation is a single SSE instruction when SSE2 is
+// available (ptest with SSE4.1) and a four-lane loop otherwise; define
+// SUDOKU_NO_SIMD to force the scalar path.
+class Bitboard
+{
+public:
+    Bitboard() = default;
+
+    static Bitboard load(const BitboardLanes& lanes)
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.data())));
+#else
+        Bitboard board;
+        board._lanes = lanes;
+        return board;
+#endif
+    }
+
+    // The same value in lanes 0-2; lane 3 stays zero.
+    static Bitboard bands(uint32_t value)
+    {
+        return load({value, value, value, 0});
+    }
+
+    BitboardLanes lanes() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        BitboardLanes result;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result.data()), _value);
+        return result;
+#else
+        return _lanes;
+#endif
+    }
+
+    bool isEmpty() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE41)
+        return _mm_testz_si128(_value, _value) != 0;
+#elif defined(SUDOKU_BITBOARD_SSE)
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_value, _mm_setzero_si128())) == 0xFFFF;
+#else
+        return (_lanes[0] | _lanes[1] | _lanes[2] | _lanes[3]) == 0;
+#endif
+    }
+
+    bool intersects(const Bitboard& other) const { return !(*this & other).isEmpty(); }
+
+    // Bit b set when band b (0-2) is zero.
+    unsigned int emptyBands() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        const __m128i zero = _mm_cmpeq_epi32(_value, _mm_setzero_si128());
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(zero))) & 7u;
+#else
+        return (_lanes[0] == 0 ? 1u : 0u) | (_lanes[1] == 0 ? 2u : 0u) | (_lanes[2] == 0 ? 4u : 0u);
+#endif
+    }
+
+    // All-ones lanes where the lane has at most one bit set, zero elsewhere.
+    Bitboard atMostOneBitLanes() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        const __m128i lowered = _mm_and_si128(_value, _mm_sub_epi32(_value, _mm_set1_epi32(1)));
+        return Bitboard(_mm_cmpeq_epi32(lowered, _mm_setzero_si128()));
+#else
+        Bitboard result;
+        for(unsigned int lane = 0; lane < 4; ++lane)
+            result._lanes[lane] = (_lanes[lane] & (_lanes[lane] - 1)) == 0 ? ~0u : 0u;
+        return result;
+#endif
+    }
+
+    template <int Count>
+    Bitboard shiftRight() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_srli_epi32(_value, Count));
+#else
+        Bitboard result;
+        for(unsigned int lane = 0; lane < 4; ++lane)
+            result._lanes[lane] = _lanes[lane] >> Count;
+        return result;
+#endif
+    }
+
+    template <int Count>
+    Bitboard shiftLeft() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_slli_epi32(_value, Count));
+#else
+        Bitboard result;
+        for(unsigned int lane = 0; lane < 4; ++lane)
+            result._lanes[lane] = _lanes[lane] << Count;
+        return result;
+#endif
+    }
+
+    // Bands rotated by one and by two lanes: lane b of the results holds bands
+    // b+1 and b+2 (mod 3). Lane 3 is kept in place.
+    Bitboard rotateBands() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_shuffle_epi32(_value, _MM_SHUFFLE(3, 0, 2, 1)));
+#else
+        return load({_lanes[1], _lanes[2], _lanes[0], _lanes[3]});
+#endif
+    }
+
+    Bitboard rotateBandsTwice() const
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_shuffle_epi32(_value, _MM_SHUFFLE(3, 1, 0, 2)));
+#else
+        return load({_lanes[2], _lanes[0], _lanes[1], _lanes[3]});
+#endif
+    }
+
+    friend Bitboard operator&(const Bitboard& a, const Bitboard& b)
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_and_si128(a._value, b._value));
+#else
+        return a.combine(b, [](uint32_t x, uint32_t y) { return x & y; });
+#endif
+    }
+
+    friend Bitboard operator|(const Bitboard& a, const Bitboard& b)
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_or_si128(a._value, b._value));
+#else
+        return a.combine(b, [](uint32_t x, uint32_t y) { return x | y; });
+#endif
+    }
+
+    // a & ~b
+    friend Bitboard andNot(const Bitboard& a, const Bitboard& b)
+    {
+#if defined(SUDOKU_BITBOARD_SSE)
+        return Bitboard(_mm_andnot_si128(b._value, a._value));
+#else
+        return a.combine(b, [](uint32_t x, uint32_t y) { return x & ~y; });
+#endif
+    }
+
+    Bitboard& operator&=(const Bitboard& other) { return *this = *this & other; }
+    Bitboard& operator|=(const Bitboard& other) { return *this = *this | other; }
+
+    // Calls f(cell) for every set bit in cell order.
+    template <typename F>
+    void forEachCell(F&& f) const
+    {
+        const BitboardLanes values = lanes();
+        for(unsigned int band = 0; band < 3; ++band)
+        {
+            for(uint32_t bits = values[band]; bits != 0; bits &= bits - 1)
+                f(band * 27 + static_cast<unsigned int>(std::countr_zero(bits)));
+        }
+    }
+
+    // Lowest set cell; the board must not be empty.
+    unsigned int firstCell() const
+    {
+        const BitboardLanes values = lanes();
+        for(unsigned int band = 0; band < 3; ++band)
+        {
+            if(values[band] != 0)
+                return band * 27 + static_cast<unsigned int>(std::countr_zero(values[band]));
+        }
+        return 81;
+    }
+
+private:
+#if defined(SUDOKU_BITBOARD_SSE)
+    explicit Bitboard(__m128i value) : _value(value) {}
+    __m128i _value = _mm_setzero_si128();
+#else
+    template <typename F>
+    Bitboard combine(const Bitboard& other, F f) const
+    {
+        Bitboard result;
+        for(unsigned int lane = 0; lane < 4; ++lane)
+            result._lanes[lane] = f(_lanes[lane], other._lanes[lane]);
+        return result;
+    }
+
+    BitboardLanes _lanes{};
+#endif
+};
+
+} // namespace sudoku
+
+#endif /* Bitboard_h */
@@ -0,0 +1,77 @@
+#ifndef BitboardSolver_h
+#define BitboardSolver_h
+
+#include <array>
+#include <cstdint>
+#include "Bitboard.h"
+#include "Grid.h"
+#include "Random.h"
+#include "SearchStats.h"
+
+namespace sudoku {
+
+// 9x9 solver working on one Bitboard of candidate cells per digit. Naked
+// singles, hidden singles in every row, column and box, dead cells and the
+// branch cell are all found with whole-board bitwise operations instead of
+// per-cell loops, and backtracking copies the 160-byte state rather than
+// undoing a trail. Same load/solve/count contract as BasicSolver<3>.
+class BitboardSolver
+{
+public:
+    using GridType = Grid;
+
+    static constexpr unsigned int kDimension = 9;
+    static constexpr unsigned int kCells = 81;
+
+    // Returns false for out-of-range or conflicting digits.
+    bool load(const GridType& cells);
+    void store(GridType& cells) const { cells = _values; }
+
+    // Finds the first solution, trying candidates in random order when an
+    // engine is given. On success the solution is left in the solver. Built
+    // for Xoshiro256PlusPlus and Pcg32.
+    template <typename Rng = RandomEngine>
+    bool solve(Rng* rng = nullptr);
+    // Counts solutions up to limit. The solver is left in its loaded state.
+    uint64_t count(uint64_t limit);
+    // Passes each solution to visit and stops as soon as it returns false.
+    // See BasicSolver::enumerate.
+    uint64_t enumerate(const SolutionVisitor& visit);
+    // True when some solution of the loaded puzzle has a digit other than
+    // value at cell, which must be empty. See BasicSolver::hasSolutionExcluding.
+    bool hasSolutionExcluding(unsigned int cell, unsigned int value);
+
+    uint64_t nodes() const { return _nodes; }
+    // Later searches add to stats until it is detached with nullptr.
+    void setSearchStats(SearchStats* stats) { _stats = stats; }
+
+private:
+    struct State
+    {
+        // Cells where each digit is still possible, including where it is placed.
+        std::array<Bitboard, kDimension> digits;
+        Bitboard unsolved;
+
+        void assign(unsigned int cell, unsigned int digit);
+        bool propagate();
+        bool placeHiddenSingles(unsigned int digit, bool& placed);
+        unsigned int chooseCell() const;
+    };
+
+    template <typename Rng>
+    bool search(State& state, Rng* rng, unsigned int depth);
+    uint64_t countImpl(State& state, uint64_t limit, unsigned int depth);
+    bool enumerateImpl(State& state, const SolutionVisitor& visit, uint64_t& visited, unsigned int depth);
+    bool propagate(State& state);
+    void record(const State& state);
+
+    State _root{};
+    GridType _values{};
+    bool _consistent = false;
+    uint64_t _nodes = 0;
+    SearchStats* _stats = nullptr;
+};
+
+} // namespace sudoku
+
+#endif /* BitboardSolver_h */
@@ -11,71 +11,140 @@
 #include <array>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <optional>
-#include <random>
 #include <stdexcept>
+#include <string>
 #include <vector>
+#include "Grader.h"
+#include "Grid.h"
+#include "SearchStats.h"
+#include "SolverContext.h"
 
 namespace sudoku {
 
-class Board
+// Work done by the most recent generatePuzzle call.
+struct GenerationStats
+{
+    // Add-one, remove-two steps taken after the greedy removal pass stalled.
+    unsigned int repairSteps = 0;
+    // Removals checked for uniqueness (or graded, when generating to a tier).
+    uint64_t uniquenessChecks = 0;
+};
+
+template <unsigned int Box, typename Rng = RandomEngine>
+class BasicBoard;
+
+template <unsigned int Box, typename Rng>
+std::ostream& operator<<(std::ostream&, const BasicBoard<Box, Rng>&);
+
+// Board of Box x Box boxes; Board (Box = 3) is the classic 9x9 game and
+// BasicBoard<4> / BasicBoard<5> are the 16x16 and 25x25 variants. A board
+// holds only its grid and per-call statistics; the random engine and search
+// engines live in a BasicSolverContext leased from the constructing thread's
+// pool for the board's lifetime, so boards are cheap to create and destroy.
+// Rng picks the random engine: Xoshiro256PlusPlus (the default) or Pcg32. A
+// seeded board produces the same boards for a given engine everywhere.
+template <unsigned int Box, typename Rng>
+class BasicBoard
 {
 public:
-    static const unsigned int BOARD_DIMENSION = 9;
+    using GridType = BasicGrid<Box>;
+    using UnitViewType = BasicUnitView<Box>;
+
+    static const unsigned int BOARD_DIMENSION = Geometry<Box>::kDimension;
 
 private:
-    std::vector<unsigned int> _boardData;
-    mutable std::vector<unsigned int> _workBuffer;
-    std::mt19937 _rng;
+    GridType _boardData{};
+    // Never null, except in a moved-from board.
+    std::unique_ptr<BasicSolverContext<Box, Rng>> _context;
+    GenerationStats _lastGenerationStats;
+    mutable SearchStats _lastSearchStats;
+    bool _searchStatsEnabled = false;
 
     unsigned int getIndexForRowColumn(unsigned int row, unsigned int column) const;
-    bool initializeMasks(const std::vector<unsigned int>& data,
-                         std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                         std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                         std::array<uint16_t, BOARD_DIMENSION>& boxMasks) const;
-    bool findBestCell(const std::vector<unsigned int>& data,
-                      const std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                      const std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                      const std::array<uint16_t, BOARD_DIMENSION>& boxMasks,
-                      unsigned int& bestIndex,
-                      uint16_t& bestCandidateMask) const;
-    bool solveBoard(std::vector<unsigned int>& data,
-                    std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                    std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                    std::array<uint16_t, BOARD_DIMENSION>& boxMasks,
-                    bool randomize);
-    bool solveBoard(std::vector<unsigned int>& data, bool randomize);
-    unsigned int countSolutionsOnData(std::vector<unsigned int>& data, unsigned int limit) const;
-    unsigned int countSolutionsImpl(std::vector<unsigned int>& data,
-                                    std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                                    std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                                    std::array<uint16_t, BOARD_DIMENSION>& boxMasks,
-                                    unsigned int limit) const;
+    bool solveBoard(GridType& data, bool randomize, SolverBackend backend);
+    uint64_t countSolutionsOnData(const GridType& data, uint64_t limit, SolverBackend backend) const;
+    // Points the engines at _lastSearchStats per call, so copies never share stats.
+    void attachSearchStats(bool reset) const;
+    // Clears cells of the solved board in random order down to clues, keeping
+    // the puzzle unique and no harder than ceiling. With repair set, a greedy
+    // pass that stalls above clues is repaired locally. Returns the clues left.
+    unsigned int removeClues(unsigned int clues, SolverBackend backend, Difficulty ceiling, bool repair);
 
 public:
-    explicit Board(std::optional<uint32_t> seed = std::nullopt);
-    ~Board();
+    // Without a seed, the leased context is seeded from its thread's
+    // entropy stream, never from an earlier board's state.
+    explicit BasicBoard(std::optional<uint32_t> seed = std::nullopt);
+    // A copy leases its own context, with the same random state.
+    BasicBoard(const BasicBoard& other);
+    // Takes other's context and leases other a new one, so a moved-from
+    // board stays usable.
+    BasicBoard(BasicBoard&& other) noexcept;
+    BasicBoard& operator=(const BasicBoard& other);
+    BasicBoard& operator=(BasicBoard&& other) noexcept;
+    // Returns the context to the destroying thread's pool.
+    ~BasicBoard();
 
     void setSeed(uint32_t seed);
 
-    std::vector<unsigned int> getRow(unsigned int) const;
-    std::vector<unsigned int> getColumn(unsigned int) const;
-    std::vector<unsigned int> getQuadrant(unsigned int) const;
+    // Naked/hidden single propagation after every assignment (on by default).
+    void setPropagationEnabled(bool enabled);
+    bool isPropagationEnabled() const;
+    // Search nodes visited by the most recent solve/count/generate call.
+    uint64_t getLastSearchNodes() const;
+    const GenerationStats& getLastGenerationStats() const { return _lastGenerationStats; }
+    // Detailed search statistics for each solve, count or generate call (a
+    // generated puzzle includes its uniqueness checks). Off by default, and
+    // always empty in builds with SUDOKU_NO_SEARCH_STATS.
+    void setSearchStatsEnabled(bool enabled) { _searchStatsEnabled = enabled; }
+    const SearchStats& getLastSearchStats() const { return _lastSearchStats; }
+
+    UnitViewType getRow(unsigned int) const;
+    UnitViewType getColumn(unsigned int) const;
+    UnitViewType getQuadrant(unsigned int) const;
 
     unsigned int getRowForIndex(unsigned int) const;
     unsigned int getColumnForIndex(unsigned int) const;
     unsigned int getQuadrantForIndex(unsigned int) const;
 
     bool isVectorUnique(const std::vector<unsigned int>&) const;
-    bool generateSolution();
-    bool generatePuzzle(unsigned int clues = 30);
-    unsigned int countSolutions(unsigned int limit = 2) const;
+    bool isUnitUnique(const UnitViewType&) const;
+    bool generateSolution(SolverBackend backend = SolverBackend::Mrv);
+    bool generatePuzzle(unsigned int clues = 30, SolverBackend backend = SolverBackend::Mrv);
+    // Puzzle of exactly the target tier, with as few clues as the tier allows.
+    // Fails when the random solution does not reach the tier; retry with new
+    // randomness. An Extreme target yields a minimal unique puzzle that the
+    // grader's techniques cannot finish.
+    bool generatePuzzle(Difficulty target, SolverBackend backend = SolverBackend::Mrv);
+    bool solve(SolverBackend backend = SolverBackend::Mrv);
+    // Rates the current board by the techniques needed to solve it.
+    Difficulty grade() const;
+    uint64_t countSolutions(uint64_t limit = 2, SolverBackend backend = SolverBackend::Mrv) const;
+    // Calls visit with each solution of the board as the search finds it,
+    // stopping as soon as visit returns false. The grid passed is only valid
+    // during the call. Returns the number of solutions visited.
+    uint64_t forEachSolution(const BasicSolutionVisitor<Box>& visit, SolverBackend backend = SolverBackend::Mrv) const;
+
+    bool loadFromString(const std::string&);
+    // Takes the cells as they are; fails for digits above the board dimension.
+    bool loadFromData(const GridType& data);
+    std::string toString() const;
 
-    friend std::ostream& operator<<(std::ostream&, const Board&);
-    inline const std::vector<unsigned int>& getBoardData() const {return _boardData;}
-    inline std::vector<unsigned int>& getBoardData() {return _boardData;}
+    friend std::ostream& operator<< <Box, Rng>(std::ostream&, const BasicBoard&);
+    inline const GridType& getBoardData() const {return _boardData;}
+    inline GridType& getBoardData() {return _boardData;}
 };
 
+extern template class BasicBoard<3>;
+extern template class BasicBoard<4>;
+extern template class BasicBoard<5>;
+extern template class BasicBoard<3, Pcg32>;
+extern template class BasicBoard<4, Pcg32>;
+extern template class BasicBoard<5, Pcg32>;
+
+using Board = BasicBoard<3>;
+
 }
 
 #endif /* Board_h */
@@ -0,0 +1,81 @@
+#ifndef Canonical_h
+#define Canonical_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include "Grid.h"
+#include "PackedCorpus.h"
+
+namespace sudoku {
+
+// One element of the 9x9 Sudoku symmetry group: an optional transposition,
+// then a row and a column permutation that keep bands and stacks together,
+// then a relabelling of the digits. Every such map takes valid grids to valid
+// grids and solutions to solutions.
+struct GridTransform
+{
+    bool transpose = false;
+    // Output row r is input row rows[r] (of the transposed grid when transpose
+    // is set); likewise for columns.
+    std::array<uint8_t, 9> rows{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    std::array<uint8_t, 9> columns{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    // digits[d] replaces input digit d; digits[0] stays 0 for empty cells.
+    std::array<uint8_t, 10> digits{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+};
+
+Grid transformGrid(const GridTransform& transform, const Grid& grid);
+// Inverse of transformGrid: maps a transformed grid (or its solution) back.
+Grid untransformGrid(const GridTransform& transform, const Grid& transformed);
+
+struct CanonicalForm
+{
+    // Smallest grid, compared cell by cell in row-major order with 0 for
+    // empty, over every transform of the input. Puzzles are equivalent up to
+    // symmetry exactly when their canonical grids are equal.
+    Grid grid{};
+    // A transform with transformGrid(transform, input) == grid.
+    GridTransform transform;
+};
+
+// Builds the canonical grid one row at a time. The first row is minimised
+// over both orientations, all nine source rows and all 1296 column orders,
+// fixing the order one stack at a time; every later row only extends the
+// orders that tie so far, with digits numbered in order of first appearance.
+// Only ties survive each row, so a typical puzzle is settled after two or
+// three rows instead of searching the 3.3 million geometric transforms.
+CanonicalForm canonicalize(const Grid& grid);
+
+// A canonical grid packed into 41 bytes, for use as a hash key.
+using CanonicalKey = std::array<uint8_t, packedRecordBytes(9)>;
+
+CanonicalKey canonicalKey(const Grid& canonical);
+
+struct CanonicalKeyHash
+{
+    std::size_t operator()(const CanonicalKey& key) const;
+};
+
+// Set of puzzles up to symmetry, keyed by their packed canonical grids. Safe
+// to use from several threads.
+class DedupIndex
+{
+public:
+    // Adds the canonical grid; false when an equivalent puzzle was added before.
+    bool insertCanonical(const Grid& canonical);
+    // Canonicalizes puzzle, then inserts it.
+    bool insert(const Grid& puzzle) { return insertCanonical(canonicalize(puzzle).grid); }
+
+    std::size_t size() const;
+    void clear();
+
+private:
+    mutable std::mutex _mutex;
+    std::unordered_set<CanonicalKey, CanonicalKeyHash> _keys;
+};
+
+} // namespace sudoku
+
+#endif /* Canonical_h */
@@ -0,0 +1,103 @@
+#ifndef DlxSolver_h
+#define DlxSolver_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Grid.h"
+#include "Random.h"
+#include "SearchStats.h"
+
+namespace sudoku {
+
+// Exact-cover solver using Knuth's Dancing Links (Algorithm X). The board is
+// encoded as 4 * D^2 constraint columns (cell filled, digit once per row,
+// column and box) and D^3 options of four nodes each. Always branching on the
+// column with the fewest remaining options cuts off dead ends that the
+// cell-only MRV search in BasicSolver only notices several levels deeper.
+//
+// The link matrix is built on the first load() and reused afterwards: every
+// cover is undone by its matching uncover, so loading the next grid only has
+// to release the previous givens.
+template <unsigned int Box>
+class BasicDlxSolver
+{
+public:
+    using Shape = Geometry<Box>;
+    using GridType = BasicGrid<Box>;
+
+    static constexpr unsigned int kDimension = Shape::kDimension;
+    static constexpr unsigned int kCells = Shape::kCells;
+
+    // Same contract as BasicSolver: false for out-of-range or conflicting givens.
+    bool load(const GridType& cells);
+    void store(GridType& cells) const { cells = _values; }
+
+    // Finds the first solution, trying options in random order when an
+    // engine is given. On success the solution is left in the solver. Built
+    // for Xoshiro256PlusPlus and Pcg32.
+    template <typename Rng = RandomEngine>
+    bool solve(Rng* rng = nullptr);
+    // Counts solutions up to limit. The solver is left in its loaded state.
+    uint64_t count(uint64_t limit);
+    // Passes each solution to visit and stops as soon as it returns false.
+    // See BasicSolver::enumerate.
+    uint64_t enumerate(const BasicSolutionVisitor<Box>& visit);
+    // True when some solution of the loaded puzzle has a digit other than
+    // value at cell, which must be empty. See BasicSolver::hasSolutionExcluding.
+    bool hasSolutionExcluding(unsigned int cell, unsigned int value);
+
+    uint64_t nodes() const { return _nodes; }
+    // Later searches add to stats until it is detached with nullptr.
+    void setSearchStats(SearchStats* stats) { _stats = stats; }
+
+private:
+    static constexpr unsigned int kColumns = 4 * kCells;
+    static constexpr unsigned int kOptions = kCells * kDimension;
+    static constexpr unsigned int kRoot = 0;
+    // Column headers are nodes [1, kColumns]; option o owns the four nodes
+    // starting at kFirstOptionNode + 4 * o.
+    static constexpr unsigned int kFirstOptionNode = kColumns + 1;
+    static constexpr unsigned int kNodes = kFirstOptionNode + 4 * kOptions;
+
+    void build();
+    // Releases selected options until only the first keep remain.
+    void release(std::size_t keep);
+    void cover(unsigned int column);
+    void uncover(unsigned int column);
+    // Covers or uncovers the other three columns of the option owning node.
+    void coverRow(unsigned int node);
+    void uncoverRow(unsigned int node);
+    void setValue(unsigned int node, bool filled);
+    unsigned int chooseColumn() const;
+    template <typename Rng>
+    bool search(Rng* rng, unsigned int depth);
+    uint64_t countImpl(uint64_t limit, unsigned int depth);
+    bool enumerateImpl(const BasicSolutionVisitor<Box>& visit, uint64_t& visited, unsigned int depth);
+
+    std::vector<uint32_t> _left;
+    std::vector<uint32_t> _right;
+    std::vector<uint32_t> _up;
+    std::vector<uint32_t> _down;
+    std::vector<uint32_t> _column;
+    std::vector<uint32_t> _size;
+
+    GridType _values{};
+    // Option nodes currently selected: the givens, followed by the solution
+    // after a successful solve(). load() releases them in reverse order.
+    std::vector<uint32_t> _selected;
+    std::size_t _givenCount = 0;
+    bool _consistent = false;
+    uint64_t _nodes = 0;
+    SearchStats* _stats = nullptr;
+};
+
+extern template class BasicDlxSolver<3>;
+extern template class BasicDlxSolver<4>;
+extern template class BasicDlxSolver<5>;
+
+using DlxSolver = BasicDlxSolver<3>;
+
+} // namespace sudoku
+
+#endif /* DlxSolver_h */
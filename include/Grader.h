@@ -0,0 +1,118 @@
+#ifndef Grader_h
+#define Grader_h
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include "Grid.h"
+
+namespace sudoku {
+
+// Difficulty tiers, named after the hardest technique a puzzle needs.
+enum class Difficulty : uint8_t
+{
+    Easy, // Naked and hidden singles.
+    Medium, // Locked candidates: pointing and claiming.
+    Hard, // Naked and hidden pairs.
+    Expert, // X-wing.
+    Extreme, // Needs more than the techniques above (or guessing).
+};
+
+inline const char* difficultyName(Difficulty difficulty)
+{
+    switch(difficulty)
+    {
+        case Difficulty::Easy: return "easy";
+        case Difficulty::Medium: return "medium";
+        case Difficulty::Hard: return "hard";
+        case Difficulty::Expert: return "expert";
+        default: return "extreme";
+    }
+}
+
+// Inverse of difficultyName; false for any other text.
+inline bool parseDifficulty(const std::string& text, Difficulty& difficulty)
+{
+    for(Difficulty tier : {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard, Difficulty::Expert, Difficulty::Extreme})
+    {
+        if(text == difficultyName(tier))
+        {
+            difficulty = tier;
+            return true;
+        }
+    }
+    return false;
+}
+
+enum class Technique : uint8_t
+{
+    NakedSingle,
+    HiddenSingle,
+    LockedCandidates,
+    NakedPair,
+    HiddenPair,
+    XWing,
+};
+
+inline constexpr unsigned int kTechniqueCount = 6;
+
+// Rates a puzzle by solving it the way a person would: always with the
+// simplest technique that makes progress, falling back to harder ones only
+// when nothing simpler applies. The candidates live in a fixed-size array of
+// masks, so grading allocates nothing and a 9x9 puzzle takes microseconds.
+template <unsigned int Box>
+class BasicGrader
+{
+public:
+    using Shape = Geometry<Box>;
+    using GridType = BasicGrid<Box>;
+    using Mask = typename Shape::Mask;
+
+    static constexpr unsigned int kDimension = Shape::kDimension;
+    static constexpr unsigned int kCells = Shape::kCells;
+
+    // Tier of the hardest technique needed to solve cells. Grading stops as
+    // soon as a technique above ceiling would be needed; the result is then
+    // the next tier up, meaning only "harder than ceiling". Puzzles the
+    // techniques cannot finish, and invalid ones, rate Extreme.
+    Difficulty grade(const GridType& cells, Difficulty ceiling = Difficulty::Extreme);
+
+    // Whether the last grade() filled every cell. A puzzle solved this way
+    // has exactly one solution, since every step was forced.
+    bool solved() const { return _solved; }
+    // Digits placed by the last grade(), 0 where it got stuck.
+    void store(GridType& cells) const { cells = _values; }
+    // Times each technique made progress during the last grade().
+    unsigned int uses(Technique technique) const { return _uses[static_cast<unsigned int>(technique)]; }
+
+private:
+    static_assert(kDimension <= 32, "Unit positions are kept in 32-bit masks");
+
+    bool load(const GridType& cells);
+    void place(unsigned int cell, unsigned int digit);
+    bool eliminate(unsigned int cell, Mask mask);
+    bool applySingles();
+    bool applyLockedCandidates();
+    bool applyNakedPairs();
+    bool applyHiddenPairs();
+    bool applyXWings();
+    void record(Technique technique) { ++_uses[static_cast<unsigned int>(technique)]; }
+
+    GridType _values{};
+    // Candidates of each empty cell; 0 for filled cells.
+    std::array<Mask, kCells> _candidates{};
+    unsigned int _emptyCount = 0;
+    bool _contradiction = false;
+    bool _solved = false;
+    std::array<unsigned int, kTechniqueCount> _uses{};
+};
+
+extern template class BasicGrader<3>;
+extern template class BasicGrader<4>;
+extern template class BasicGrader<5>;
+
+using Grader = BasicGrader<3>;
+
+} // namespace sudoku
+
+#endif /* Grader_h */
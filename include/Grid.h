@@ -0,0 +1,166 @@
+#ifndef Grid_h
+#define Grid_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+namespace sudoku {
+
+// Compile-time shape of a board made of Box x Box boxes (3 for classic 9x9,
+// 4 for 16x16, 5 for 25x25). Everything sized by the board derives from here,
+// so each instantiation is as specialised as a hand-written fixed-size engine.
+template <unsigned int Box>
+struct Geometry
+{
+    static_assert(Box >= 2 && Box <= 6, "Supported boards range from 4x4 to 36x36");
+
+    static constexpr unsigned int kBoxDimension = Box;
+    static constexpr unsigned int kDimension = Box * Box;
+    static constexpr unsigned int kCells = kDimension * kDimension;
+    static constexpr unsigned int kUnits = kDimension * 3;
+    static constexpr unsigned int kPeers = 3 * (kDimension - 1) - 2 * (Box - 1);
+
+    // Digit d is bit (1 << d), so a mask needs kDimension + 1 bits.
+    using Mask = std::conditional_t<(kDimension < 16), uint16_t,
+                 std::conditional_t<(kDimension < 32), uint32_t, uint64_t>>;
+    // Smallest type that can index every cell.
+    using Cell = std::conditional_t<(kCells <= 256), uint8_t, uint16_t>;
+
+    static constexpr Mask kAllDigits = static_cast<Mask>(((Mask{1} << kDimension) - 1) << 1);
+};
+
+// One byte per cell, 0 for empty. Copying a grid is a plain memcpy.
+template <unsigned int Box>
+using BasicGrid = std::array<uint8_t, Geometry<Box>::kCells>;
+
+using Grid = BasicGrid<3>;
+
+// Receives each solution of an enumeration in turn and returns false to stop
+// it. The grid is the engine's working state, valid only during the call;
+// copy it to keep it.
+template <unsigned int Box>
+using BasicSolutionVisitor = std::function<bool(const BasicGrid<Box>&)>;
+
+using SolutionVisitor = BasicSolutionVisitor<3>;
+
+static_assert(sizeof(Grid) <= 81, "Grid must stay within one byte per cell");
+static_assert(std::is_trivially_copyable_v<Grid>, "Grid must be trivially copyable");
+
+// Text form of a digit: 1-9, then A-Z and a-z for larger boards; '.' for empty.
+inline char digitToChar(unsigned int value)
+{
+    if(value == 0)
+        return '.';
+    if(value < 10)
+        return static_cast<char>('0' + value);
+    if(value < 36)
+        return static_cast<char>('A' + (value - 10));
+    return static_cast<char>('a' + (value - 36));
+}
+
+// Inverse of digitToChar; '.' and '0' read as empty. Returns -1 for other characters.
+inline int digitFromChar(char c)
+{
+    if(c == '.' || c == '0')
+        return 0;
+    if(c >= '1' && c <= '9')
+        return c - '0';
+    if(c >= 'A' && c <= 'Z')
+        return c - 'A' + 10;
+    if(c >= 'a' && c <= 'z')
+        return c - 'a' + 36;
+    return -1;
+}
+
+// Read-only view of one row, column or box of a grid. Cells are addressed as a
+// Box x Box block of positions, so all three unit kinds share one lookup:
+// offset = (position / Box) * majorStride + (position % Box) * minorStride.
+template <unsigned int Box>
+class BasicUnitView
+{
+public:
+    using Shape = Geometry<Box>;
+    class Iterator;
+
+    static BasicUnitView row(const BasicGrid<Box>& grid, unsigned int index)
+    {
+        return BasicUnitView(grid.data() + index * Shape::kDimension, Box, 1);
+    }
+
+    static BasicUnitView column(const BasicGrid<Box>& grid, unsigned int index)
+    {
+        return BasicUnitView(grid.data() + index, Box * Shape::kDimension, Shape::kDimension);
+    }
+
+    static BasicUnitView box(const BasicGrid<Box>& grid, unsigned int index)
+    {
+        const unsigned int firstRow = (index / Box) * Box;
+        const unsigned int firstColumn = (index % Box) * Box;
+        return BasicUnitView(grid.data() + firstRow * Shape::kDimension + firstColumn, Shape::kDimension, 1);
+    }
+
+    unsigned int operator[](unsigned int position) const
+    {
+        return _first[(position / Box) * _majorStride + (position % Box) * _minorStride];
+    }
+
+    static constexpr unsigned int size() { return Shape::kDimension; }
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    BasicUnitView() = default;
+    BasicUnitView(const uint8_t* first, unsigned int majorStride, unsigned int minorStride)
+        : _first(first), _majorStride(majorStride), _minorStride(minorStride)
+    {
+    }
+
+    const uint8_t* _first = nullptr;
+    unsigned int _majorStride = 0;
+    unsigned int _minorStride = 0;
+};
+
+template <unsigned int Box>
+class BasicUnitView<Box>::Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = unsigned int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = unsigned int;
+
+    Iterator() = default;
+    Iterator(const BasicUnitView& view, unsigned int position) : _view(view), _position(position) {}
+
+    unsigned int operator*() const { return _view[_position]; }
+    Iterator& operator++() { ++_position; return *this; }
+    Iterator operator++(int) { Iterator previous = *this; ++_position; return previous; }
+    bool operator==(const Iterator& other) const { return _position == other._position; }
+
+private:
+    BasicUnitView _view;
+    unsigned int _position = 0;
+};
+
+template <unsigned int Box>
+inline typename BasicUnitView<Box>::Iterator BasicUnitView<Box>::begin() const
+{
+    return Iterator(*this, 0);
+}
+
+template <unsigned int Box>
+inline typename BasicUnitView<Box>::Iterator BasicUnitView<Box>::end() const
+{
+    return Iterator(*this, Shape::kDimension);
+}
+
+using UnitView = BasicUnitView<3>;
+
+} // namespace sudoku
+
+#endif /* Grid_h */
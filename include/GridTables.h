@@ -0,0 +1,70 @@
+#ifndef GridTables_h
+#define GridTables_h
+
+#include <array>
+#include "Grid.h"
+
+namespace sudoku {
+
+// Unit and peer lookup tables, built at compile time for each board size.
+template <unsigned int Box>
+struct GridTables
+{
+    using Shape = Geometry<Box>;
+    using Cell = typename Shape::Cell;
+
+    // Units [0, D) are rows, [D, 2D) columns and [2D, 3D) boxes.
+    std::array<std::array<Cell, Shape::kDimension>, Shape::kUnits> units{};
+    std::array<std::array<Cell, Shape::kPeers>, Shape::kCells> peers{};
+    // Row, column and box of each cell.
+    std::array<std::array<uint8_t, 3>, Shape::kCells> cellUnits{};
+};
+
+template <unsigned int Box>
+constexpr GridTables<Box> makeGridTables()
+{
+    using Shape = Geometry<Box>;
+    using Cell = typename Shape::Cell;
+    constexpr unsigned int D = Shape::kDimension;
+
+    GridTables<Box> tables{};
+    for(unsigned int cell = 0; cell < Shape::kCells; ++cell)
+    {
+        const unsigned int row = cell / D;
+        const unsigned int column = cell % D;
+        const unsigned int box = (row / Box) * Box + column / Box;
+        const unsigned int boxPosition = (row % Box) * Box + column % Box;
+        tables.units[row][column] = static_cast<Cell>(cell);
+        tables.units[D + column][row] = static_cast<Cell>(cell);
+        tables.units[2 * D + box][boxPosition] = static_cast<Cell>(cell);
+        tables.cellUnits[cell] = {static_cast<uint8_t>(row), static_cast<uint8_t>(column), static_cast<uint8_t>(box)};
+    }
+
+    // Peers are listed in cell order: the cell's own row, the rest of its
+    // box in the rows of its band and its column everywhere else.
+    for(unsigned int cell = 0; cell < Shape::kCells; ++cell)
+    {
+        const unsigned int row = cell / D;
+        const unsigned int column = cell % D;
+        unsigned int count = 0;
+        for(unsigned int otherRow = 0; otherRow < D; ++otherRow)
+        {
+            for(unsigned int otherColumn = 0; otherColumn < D; ++otherColumn)
+            {
+                const bool peer = otherRow == row
+                    ? otherColumn != column
+                    : otherColumn == column || (otherRow / Box == row / Box && otherColumn / Box == column / Box);
+                if(peer)
+                    tables.peers[cell][count++] = static_cast<Cell>(otherRow * D + otherColumn);
+            }
+        }
+    }
+    return tables;
+}
+
+template <unsigned int Box>
+inline constexpr GridTables<Box> kGridTables = makeGridTables<Box>();
+
+} // namespace sudoku
+
+#endif /* GridTables_h */
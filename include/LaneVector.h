@@ -0,0 +1,252 @@
+#ifndef LaneVector_h
+#define LaneVector_h
+
+#include <array>
+#include <cstdint>
+
+#if !defined(SUDOKU_NO_SIMD) && defined(__AVX2__)
+#define SUDOKU_LANES_AVX2 1
+#include <immintrin.h>
+#elif !defined(SUDOKU_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SUDOKU_LANES_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace sudoku {
+
+// One 16-bit value per lane: 16 lanes with AVX2, 8 with SSE2, and an
+// eight-lane loop otherwise (or when SUDOKU_NO_SIMD is defined). The batch
+// solver keeps the same cell of different puzzles side by side in one
+// vector. Comparisons return all-ones lanes where they hold and zero lanes
+// elsewhere, for use with select() and laneBits().
+class LaneVector
+{
+public:
+#if defined(SUDOKU_LANES_AVX2)
+    static constexpr unsigned int kLanes = 16;
+#else
+    static constexpr unsigned int kLanes = 8;
+#endif
+    using Lanes = std::array<uint16_t, kLanes>;
+
+    LaneVector() = default;
+
+    static LaneVector load(const uint16_t* values)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values)));
+#else
+        LaneVector vector;
+        for(unsigned int lane = 0; lane < kLanes; ++lane)
+            vector._lanes[lane] = values[lane];
+        return vector;
+#endif
+    }
+
+    void store(uint16_t* values) const
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), _value);
+#elif defined(SUDOKU_LANES_SSE)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values), _value);
+#else
+        for(unsigned int lane = 0; lane < kLanes; ++lane)
+            values[lane] = _lanes[lane];
+#endif
+    }
+
+    // The same value in every lane.
+    static LaneVector splat(uint16_t value)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_set1_epi16(static_cast<short>(value)));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_set1_epi16(static_cast<short>(value)));
+#else
+        LaneVector vector;
+        vector._lanes.fill(value);
+        return vector;
+#endif
+    }
+
+    bool isEmpty() const
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return _mm256_testz_si256(_value, _value) != 0;
+#elif defined(SUDOKU_LANES_SSE)
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_value, _mm_setzero_si128())) == 0xFFFF;
+#else
+        for(uint16_t value : _lanes)
+        {
+            if(value != 0)
+                return false;
+        }
+        return true;
+#endif
+    }
+
+    // Bit l set when lane l is non-zero; meant for comparison results.
+    uint32_t laneBits() const
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        // Packing works per 128-bit half: lanes 0-7 land in bytes 0-7 and
+        // lanes 8-15 in bytes 16-23.
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i set = _mm256_xor_si256(_mm256_cmpeq_epi16(_value, zero), _mm256_set1_epi16(-1));
+        const uint32_t bytes = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(set, zero)));
+        return (bytes & 0xFFu) | ((bytes >> 8) & 0xFF00u);
+#elif defined(SUDOKU_LANES_SSE)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i set = _mm_xor_si128(_mm_cmpeq_epi16(_value, zero), _mm_set1_epi16(-1));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(set, zero)));
+#else
+        uint32_t bits = 0;
+        for(unsigned int lane = 0; lane < kLanes; ++lane)
+            bits |= _lanes[lane] != 0 ? 1u << lane : 0u;
+        return bits;
+#endif
+    }
+
+    // All-ones lanes where the lane is zero.
+    LaneVector zeroLanes() const { return equal(*this, LaneVector()); }
+
+    // All-ones lanes where the lane has at most one bit set.
+    LaneVector atMostOneBitLanes() const { return (*this & (*this - splat(1))).zeroLanes(); }
+
+    // Bits set in each lane.
+    LaneVector popcount() const
+    {
+        LaneVector bits = *this - (shiftRight<1>() & splat(0x5555));
+        bits = (bits & splat(0x3333)) + (bits.shiftRight<2>() & splat(0x3333));
+        bits = (bits + bits.shiftRight<4>()) & splat(0x0F0F);
+        return (bits + bits.shiftRight<8>()) & splat(0x1F);
+    }
+
+    template <int Count>
+    LaneVector shiftRight() const
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_srli_epi16(_value, Count));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_srli_epi16(_value, Count));
+#else
+        return combine(*this, *this, [](uint16_t x, uint16_t) { return static_cast<uint16_t>(x >> Count); });
+#endif
+    }
+
+    friend LaneVector operator+(const LaneVector& a, const LaneVector& b)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_add_epi16(a._value, b._value));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_add_epi16(a._value, b._value));
+#else
+        return combine(a, b, [](uint16_t x, uint16_t y) { return static_cast<uint16_t>(x + y); });
+#endif
+    }
+
+    friend LaneVector operator-(const LaneVector& a, const LaneVector& b)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_sub_epi16(a._value, b._value));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_sub_epi16(a._value, b._value));
+#else
+        return combine(a, b, [](uint16_t x, uint16_t y) { return static_cast<uint16_t>(x - y); });
+#endif
+    }
+
+    friend LaneVector operator&(const LaneVector& a, const LaneVector& b)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_and_si256(a._value, b._value));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_and_si128(a._value, b._value));
+#else
+        return combine(a, b, [](uint16_t x, uint16_t y) { return static_cast<uint16_t>(x & y); });
+#endif
+    }
+
+    friend LaneVector operator|(const LaneVector& a, const LaneVector& b)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_or_si256(a._value, b._value));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_or_si128(a._value, b._value));
+#else
+        return combine(a, b, [](uint16_t x, uint16_t y) { return static_cast<uint16_t>(x | y); });
+#endif
+    }
+
+    // a & ~b
+    friend LaneVector andNot(const LaneVector& a, const LaneVector& b)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_andnot_si256(b._value, a._value));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_andnot_si128(b._value, a._value));
+#else
+        return combine(a, b, [](uint16_t x, uint16_t y) { return static_cast<uint16_t>(x & ~y); });
+#endif
+    }
+
+    friend LaneVector equal(const LaneVector& a, const LaneVector& b)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_cmpeq_epi16(a._value, b._value));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_cmpeq_epi16(a._value, b._value));
+#else
+        return combine(a, b, [](uint16_t x, uint16_t y) { return static_cast<uint16_t>(x == y ? 0xFFFF : 0); });
+#endif
+    }
+
+    // Signed comparison; the solver only compares small counts.
+    friend LaneVector less(const LaneVector& a, const LaneVector& b)
+    {
+#if defined(SUDOKU_LANES_AVX2)
+        return LaneVector(_mm256_cmpgt_epi16(b._value, a._value));
+#elif defined(SUDOKU_LANES_SSE)
+        return LaneVector(_mm_cmplt_epi16(a._value, b._value));
+#else
+        return combine(a, b, [](uint16_t x, uint16_t y) {
+            return static_cast<uint16_t>(static_cast<int16_t>(x) < static_cast<int16_t>(y) ? 0xFFFF : 0);
+        });
+#endif
+    }
+
+    // Lanes of a where mask is all-ones, of b where it is zero.
+    friend LaneVector select(const LaneVector& mask, const LaneVector& a, const LaneVector& b)
+    {
+        return (a & mask) | andNot(b, mask);
+    }
+
+    LaneVector& operator&=(const LaneVector& other) { return *this = *this & other; }
+    LaneVector& operator|=(const LaneVector& other) { return *this = *this | other; }
+
+private:
+#if defined(SUDOKU_LANES_AVX2)
+    explicit LaneVector(__m256i value) : _value(value) {}
+    __m256i _value = _mm256_setzero_si256();
+#elif defined(SUDOKU_LANES_SSE)
+    explicit LaneVector(__m128i value) : _value(value) {}
+    __m128i _value = _mm_setzero_si128();
+#else
+    template <typename F>
+    static LaneVector combine(const LaneVector& a, const LaneVector& b, F f)
+    {
+        LaneVector result;
+        for(unsigned int lane = 0; lane < kLanes; ++lane)
+            result._lanes[lane] = f(a._lanes[lane], b._lanes[lane]);
+        return result;
+    }
+
+    Lanes _lanes{};
+#endif
+};
+
+} // namespace sudoku
+
+#endif /* LaneVector_h */
@@ -0,0 +1,201 @@
+#ifndef PackedCorpus_h
+#define PackedCorpus_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Grid.h"
+
+namespace sudoku {
+
+// Binary puzzle corpus: a 16-byte header followed by fixed-size records.
+//
+//   offset 0  "SDKP"
+//   offset 4  format version (1)
+//   offset 5  board dimension (9, 16 or 25)
+//   offset 6  bits per cell
+//   offset 7  reserved (0)
+//   offset 8  record count, 64-bit little-endian
+//
+// Each record packs the cells in row-major order into a little-endian bit
+// stream, 0 for empty. A 9x9 board takes 4 bits per cell, so one puzzle is
+// 41 bytes; 16x16 and 25x25 boards take 5 bits per cell.
+inline constexpr std::size_t kPackedHeaderBytes = 16;
+inline constexpr uint8_t kPackedVersion = 1;
+
+constexpr unsigned int packedBitsPerCell(unsigned int dimension)
+{
+    unsigned int bits = 1;
+    while((1u << bits) <= dimension)
+        ++bits;
+    return bits;
+}
+
+constexpr std::size_t packedRecordBytes(unsigned int dimension)
+{
+    return (static_cast<std::size_t>(dimension) * dimension * packedBitsPerCell(dimension) + 7) / 8;
+}
+
+static_assert(packedRecordBytes(9) == 41, "A packed 9x9 puzzle is 41 bytes");
+
+template <unsigned int Box>
+void packGrid(const BasicGrid<Box>& grid, uint8_t* out)
+{
+    constexpr unsigned int kBits = packedBitsPerCell(Geometry<Box>::kDimension);
+    if constexpr(kBits == 4)
+    {
+        std::size_t cell = 0;
+        for(; cell + 1 < grid.size(); cell += 2)
+            *out++ = static_cast<uint8_t>(grid[cell] | (grid[cell + 1] << 4));
+        if(cell < grid.size())
+            *out = grid[cell];
+    }
+    else
+    {
+        uint32_t pending = 0;
+        unsigned int pendingBits = 0;
+        for(uint8_t value : grid)
+        {
+            pending |= static_cast<uint32_t>(value) << pendingBits;
+            pendingBits += kBits;
+            for(; pendingBits >= 8; pendingBits -= 8, pending >>= 8)
+                *out++ = static_cast<uint8_t>(pending);
+        }
+        if(pendingBits != 0)
+            *out = static_cast<uint8_t>(pending);
+    }
+}
+
+template <unsigned int Box>
+void unpackGrid(const uint8_t* in, BasicGrid<Box>& grid)
+{
+    constexpr unsigned int kBits = packedBitsPerCell(Geometry<Box>::kDimension);
+    if constexpr(kBits == 4)
+    {
+        std::size_t cell = 0;
+        for(; cell + 1 < grid.size(); cell += 2, ++in)
+        {
+            grid[cell] = static_cast<uint8_t>(*in & 0xF);
+            grid[cell + 1] = static_cast<uint8_t>(*in >> 4);
+        }
+        if(cell < grid.size())
+            grid[cell] = static_cast<uint8_t>(*in & 0xF);
+    }
+    else
+    {
+        constexpr uint32_t kCellMask = (1u << kBits) - 1;
+        uint32_t pending = 0;
+        unsigned int pendingBits = 0;
+        for(uint8_t& value : grid)
+        {
+            if(pendingBits < kBits)
+            {
+                pending |= static_cast<uint32_t>(*in++) << pendingBits;
+                pendingBits += 8;
+            }
+            value = static_cast<uint8_t>(pending & kCellMask);
+            pending >>= kBits;
+            pendingBits -= kBits;
+        }
+    }
+}
+
+// Read-only view of a packed corpus mapped into memory. Records are unpacked
+// straight from the mapping, so reading any number of puzzles allocates
+// nothing. Uses mmap on POSIX systems and a file mapping on Windows.
+class PackedReader
+{
+public:
+    PackedReader() = default;
+    ~PackedReader();
+
+    PackedReader(const PackedReader&) = delete;
+    PackedReader& operator=(const PackedReader&) = delete;
+
+    // Maps path; returns false if it cannot be mapped, has no valid header or
+    // is shorter than its record count says.
+    bool open(const std::string& path);
+    void close();
+
+    // True when path starts with a packed corpus header.
+    static bool isPackedFile(const std::string& path);
+
+    unsigned int dimension() const { return _dimension; }
+    uint64_t size() const { return _count; }
+    const uint8_t* record(uint64_t index) const { return _records + index * _recordBytes; }
+
+    // Unpacks record index; fails for a board of another dimension or an
+    // index past the end.
+    template <unsigned int Box>
+    bool read(uint64_t index, BasicGrid<Box>& grid) const
+    {
+        if(_dimension != Geometry<Box>::kDimension || index >= _count)
+            return false;
+        unpackGrid<Box>(record(index), grid);
+        return true;
+    }
+
+private:
+    const uint8_t* _data = nullptr;
+    std::size_t _length = 0;
+    const uint8_t* _records = nullptr;
+    std::size_t _recordBytes = 0;
+    unsigned int _dimension = 0;
+    uint64_t _count = 0;
+#ifdef _WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#endif
+};
+
+// Writes a packed corpus through one reusable buffer. The record count in the
+// header is filled in by close(), so the output must be a seekable file.
+class PackedWriter
+{
+public:
+    static constexpr std::size_t kBufferBytes = 1 << 20;
+
+    PackedWriter() = default;
+    ~PackedWriter();
+
+    PackedWriter(const PackedWriter&) = delete;
+    PackedWriter& operator=(const PackedWriter&) = delete;
+
+    bool open(const std::string& path, unsigned int dimension);
+    // Flushes the buffer and writes the final header. Returns false if any
+    // write failed.
+    bool close();
+
+    uint64_t size() const { return _count; }
+
+    template <unsigned int Box>
+    bool write(const BasicGrid<Box>& grid)
+    {
+        if(_file == nullptr || _dimension != Geometry<Box>::kDimension)
+            return false;
+        if(_used + _recordBytes > _buffer.size() && !flush())
+            return false;
+        packGrid<Box>(grid, _buffer.data() + _used);
+        _used += _recordBytes;
+        ++_count;
+        return true;
+    }
+
+private:
+    bool flush();
+    bool writeHeader();
+
+    std::FILE* _file = nullptr;
+    std::vector<uint8_t> _buffer;
+    std::size_t _used = 0;
+    std::size_t _recordBytes = 0;
+    unsigned int _dimension = 0;
+    uint64_t _count = 0;
+    bool _failed = false;
+};
+
+} // namespace sudoku
+
+#endif /* PackedCorpus_h */
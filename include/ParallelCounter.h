@@ -0,0 +1,97 @@
+#ifndef ParallelCounter_h
+#define ParallelCounter_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Grid.h"
+#include "SearchStats.h"
+#include "Solver.h"
+#include "WorkerPool.h"
+
+namespace sudoku {
+
+// Counts solutions on all workers of a pool. The top of the search tree is
+// split into tasks: each task is a partial grid, split further on its most
+// constrained cell while other workers are idle and counted with a
+// per-worker BasicSolver otherwise. Every worker owns a deque; it pushes and
+// pops its own tasks at the back (depth first) and steals from the front of
+// the others (the largest subtrees) when it runs dry. The total is shared
+// through an atomic, so workers stop taking tasks once the limit is reached.
+template <unsigned int Box>
+class BasicParallelCounter
+{
+public:
+    using Shape = Geometry<Box>;
+    using GridType = BasicGrid<Box>;
+
+    explicit BasicParallelCounter(unsigned int threadCount = WorkerPool::defaultThreadCount());
+
+    // Solutions of cells, up to limit. Invalid grids have none.
+    uint64_t count(const GridType& cells, uint64_t limit);
+
+    unsigned int threadCount() const { return _pool.size(); }
+    // Statistics of the most recent count() call.
+    uint64_t nodes() const { return _nodes.load(); }
+    uint64_t tasks() const { return _tasks.load(); }
+    uint64_t steals() const { return _steals.load(); }
+    // Collects the SearchStats of every worker's task searches, merged after
+    // each count(). Depths count from the task a search started at.
+    void setSearchStatsEnabled(bool enabled);
+    const SearchStats& searchStats() const { return _searchStats; }
+
+private:
+    struct Task
+    {
+        GridType cells;
+        unsigned int depth;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(unsigned int worker, Task&& task);
+    bool pop(unsigned int worker, Task& task);
+    bool steal(unsigned int worker, Task& task);
+    void runWorker(unsigned int worker);
+    void process(unsigned int worker, Task& task);
+    bool split(unsigned int worker, const Task& task);
+
+    WorkerPool _pool;
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+    std::vector<std::unique_ptr<BasicSolver<Box>>> _solvers;
+    std::vector<SearchStats> _workerStats;
+    SearchStats _searchStats;
+
+    uint64_t _limit = 0;
+    std::atomic<uint64_t> _found{0};
+    // Tasks pushed but not yet finished; the run ends when it drops to zero.
+    std::atomic<uint64_t> _outstanding{0};
+    std::atomic<unsigned int> _idle{0};
+    // Idle workers park on _parked until a push bumps _pushes or the run
+    // ends, instead of spinning through the queues.
+    std::atomic<uint64_t> _pushes{0};
+    std::mutex _parkMutex;
+    std::condition_variable _parked;
+    std::atomic<uint64_t> _nodes{0};
+    std::atomic<uint64_t> _tasks{0};
+    std::atomic<uint64_t> _steals{0};
+};
+
+extern template class BasicParallelCounter<3>;
+extern template class BasicParallelCounter<4>;
+extern template class BasicParallelCounter<5>;
+
+using ParallelCounter = BasicParallelCounter<3>;
+
+} // namespace sudoku
+
+#endif /* ParallelCounter_h */
@@ -1,6 +1,7 @@
 #ifndef ParseUtils_h
 #define ParseUtils_h
 
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 
@@ -18,6 +19,18 @@ inline bool parseUnsigned(const std::string& value, unsigned int& out)
     return true;
 }
 
+inline bool parseUnsigned(const std::string& value, uint64_t& out)
+{
+    if(value.empty())
+        return false;
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(value.c_str(), &end, 10);
+    if(end == value.c_str() || *end != '\0')
+        return false;
+    out = static_cast<uint64_t>(parsed);
+    return true;
+}
+
 } // namespace sudoku
 
 #endif /* ParseUtils_h */
@@ -0,0 +1,125 @@
+#ifndef PlaySession_h
+#define PlaySession_h
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "Grid.h"
+
+namespace sudoku {
+
+// Why a hint's digit belongs in its cell.
+enum class HintReason
+{
+    NakedSingle, // The only digit no peer holds.
+    HiddenSingle, // The only place left for the digit in a row, column or box.
+    Solution, // Taken from the puzzle's solution; no single is on the board.
+};
+
+struct Hint
+{
+    unsigned int cell = 0;
+    unsigned int digit = 0;
+    HintReason reason = HintReason::NakedSingle;
+};
+
+// State of a game in progress for an interactive front end. Each row, column
+// and box keeps a count of every digit in it and a mask of the digits
+// present, so a move touches three counters and at most three masks: place,
+// erase, undo and redo take constant time, and a cell's candidates and
+// conflicts are read from the masks and counts of its three units without
+// scanning them. Entries may conflict; conflicts are reported, not refused.
+// Moves go on an unbounded history, and a new move drops the moves undone
+// before it.
+template <unsigned int Box>
+class BasicPlaySession
+{
+public:
+    using Shape = Geometry<Box>;
+    using GridType = BasicGrid<Box>;
+    using Mask = typename Shape::Mask;
+
+    static constexpr unsigned int kDimension = Shape::kDimension;
+    static constexpr unsigned int kCells = Shape::kCells;
+
+    // Starts on an empty grid with no givens.
+    BasicPlaySession();
+
+    // Starts a new game on puzzle, whose filled cells become the givens, and
+    // clears the history. Fails, leaving the session as it was, for digits
+    // above the board dimension.
+    bool load(const GridType& puzzle);
+
+    // Writes digit (1 to kDimension) into cell, or empties it for 0. Fails
+    // for givens and out-of-range cells or digits. Writing the digit a cell
+    // already holds succeeds without adding a move.
+    bool place(unsigned int cell, unsigned int digit);
+    bool erase(unsigned int cell) { return place(cell, 0); }
+    // Take back the last move, or make the last undone move again; false
+    // when there is none.
+    bool undo();
+    bool redo();
+    bool canUndo() const { return _position != 0; }
+    bool canRedo() const { return _position != _history.size(); }
+
+    unsigned int digit(unsigned int cell) const { return _cells[cell]; }
+    bool isGiven(unsigned int cell) const { return _givens[cell] != 0; }
+    const GridType& grid() const { return _cells; }
+
+    // Digits (bit 1 << d) that no cell of the row, column or box holds; 0 for
+    // a filled cell.
+    Mask candidates(unsigned int cell) const;
+    // True when another cell of the row, column or box holds the cell's digit.
+    bool hasConflict(unsigned int cell) const;
+    // Digits held more than once in a unit, counted once per unit.
+    unsigned int conflictCount() const { return _conflicts; }
+    unsigned int filledCount() const { return _filled; }
+    bool isSolved() const { return _filled == kCells && _conflicts == 0; }
+
+    // A move for an empty cell: a naked single, else a hidden single, else
+    // a digit of the puzzle's solution. Singles follow from the entries on
+    // the board, so a wrong entry can lead to a hint that is wrong too.
+    // Empty when the board is full, has conflicts, or the puzzle has no
+    // solution to fall back on.
+    std::optional<Hint> hint() const;
+
+private:
+    struct Move
+    {
+        uint16_t cell;
+        uint8_t before;
+        uint8_t after;
+    };
+
+    void add(unsigned int cell, unsigned int digit);
+    void remove(unsigned int cell, unsigned int digit);
+    // Writes the cell without touching the history.
+    void set(unsigned int cell, unsigned int digit);
+    std::optional<Hint> hiddenSingle() const;
+
+    GridType _givens{};
+    GridType _cells{};
+    // Units [0, D) are rows, [D, 2D) columns and [2D, 3D) boxes, as in
+    // GridTables.
+    std::array<std::array<uint8_t, kDimension + 1>, Shape::kUnits> _counts{};
+    std::array<Mask, Shape::kUnits> _present{};
+    unsigned int _conflicts = 0;
+    unsigned int _filled = 0;
+    std::vector<Move> _history;
+    // Moves [0, _position) are on the board; the rest can be redone.
+    std::size_t _position = 0;
+    // Solution of the givens, found on the first hint that needs it.
+    mutable std::optional<GridType> _solution;
+    mutable bool _solutionSearched = false;
+};
+
+extern template class BasicPlaySession<3>;
+extern template class BasicPlaySession<4>;
+extern template class BasicPlaySession<5>;
+
+using PlaySession = BasicPlaySession<3>;
+
+} // namespace sudoku
+
+#endif /* PlaySession_h */
@@ -0,0 +1,160 @@
+#ifndef Random_h
+#define Random_h
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace sudoku {
+
+// SplitMix64 output function: a bijective mix with good avalanche, used to
+// spread consecutive inputs over the whole 64-bit range.
+constexpr uint64_t splitMix64(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Seed for task index of a run started from masterSeed. Depends only on the
+// two inputs, so a task produces the same output whichever thread runs it.
+constexpr uint32_t deriveSeed(uint64_t masterSeed, uint64_t index)
+{
+    return static_cast<uint32_t>(splitMix64(masterSeed ^ splitMix64(index)) >> 32);
+}
+
+// xoshiro256++ (Blackman and Vigna): 32 bytes of state, a few cycles per
+// 64-bit output, and ample quality for search ordering and shuffles.
+class Xoshiro256PlusPlus
+{
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256PlusPlus(uint64_t seed = 0) { this->seed(seed); }
+
+    // Expands seed through SplitMix64, so nearby seeds give unrelated streams
+    // and the state is never all zero.
+    void seed(uint64_t seed)
+    {
+        for(uint64_t& word : _state)
+        {
+            word = splitMix64(seed);
+            seed += 0x9E3779B97F4A7C15ull;
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const uint64_t result = std::rotl(_state[0] + _state[3], 23) + _state[0];
+        const uint64_t shifted = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= shifted;
+        _state[3] = std::rotl(_state[3], 45);
+        return result;
+    }
+
+    friend bool operator==(const Xoshiro256PlusPlus&, const Xoshiro256PlusPlus&) = default;
+
+private:
+    std::array<uint64_t, 4> _state{};
+};
+
+// PCG32 (O'Neill), XSH-RR output on a 64-bit LCG: 16 bytes of state.
+class Pcg32
+{
+public:
+    using result_type = uint32_t;
+
+    explicit Pcg32(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed)
+    {
+        _state = 0;
+        (*this)();
+        _state += splitMix64(seed);
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const uint64_t previous = _state;
+        _state = previous * 6364136223846793005ull + kIncrement;
+        const uint32_t xorShifted = static_cast<uint32_t>(((previous >> 18) ^ previous) >> 27);
+        return std::rotr(xorShifted, static_cast<int>(previous >> 59));
+    }
+
+    friend bool operator==(const Pcg32&, const Pcg32&) = default;
+
+private:
+    static constexpr uint64_t kIncrement = 1442695040888963407ull;
+
+    uint64_t _state = 0;
+};
+
+// Engine of boards and solver contexts unless another one is named.
+using RandomEngine = Xoshiro256PlusPlus;
+
+// 32 random bits from a 32- or 64-bit engine (the high half of a 64-bit
+// output, which is the stronger half for xoshiro).
+template <typename Rng>
+uint32_t randomBits32(Rng& rng)
+{
+    static_assert(Rng::min() == 0, "Engines must produce full-width outputs");
+    if constexpr(Rng::max() > std::numeric_limits<uint32_t>::max())
+        return static_cast<uint32_t>(rng() >> 32);
+    else
+        return static_cast<uint32_t>(rng());
+}
+
+// Uniform value in [0, bound) for bound >= 1, by Lemire's multiply-and-shift
+// with rejection: one multiplication per call in almost every case, and the
+// same sequence on every standard library, unlike std::uniform_int_distribution.
+template <typename Rng>
+uint32_t uniformBelow(Rng& rng, uint32_t bound)
+{
+    uint64_t product = static_cast<uint64_t>(randomBits32(rng)) * bound;
+    if(static_cast<uint32_t>(product) < bound)
+    {
+        const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+        while(static_cast<uint32_t>(product) < threshold)
+            product = static_cast<uint64_t>(randomBits32(rng)) * bound;
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+// Index of a set bit of mask, each equally likely; mask must not be zero.
+// Drawing bits one at a time and clearing them visits the candidates in a
+// uniformly random order without building and shuffling an array.
+template <typename Rng, typename Mask>
+unsigned int randomSetBit(Rng& rng, Mask mask)
+{
+    for(uint32_t skip = uniformBelow(rng, static_cast<uint32_t>(std::popcount(mask))); skip != 0; --skip)
+        mask &= static_cast<Mask>(mask - 1);
+    return static_cast<unsigned int>(std::countr_zero(mask));
+}
+
+// Fisher-Yates shuffle on uniformBelow, so a seeded engine gives the same
+// order everywhere (std::shuffle's draws are implementation-defined).
+template <typename Iterator, typename Rng>
+void shuffleRange(Iterator first, Iterator last, Rng& rng)
+{
+    for(auto count = std::distance(first, last); count > 1; --count)
+        std::iter_swap(first + (count - 1), first + uniformBelow(rng, static_cast<uint32_t>(count)));
+}
+
+} // namespace sudoku
+
+#endif /* Random_h */
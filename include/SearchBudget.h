@@ -0,0 +1,63 @@
+#ifndef SearchBudget_h
+#define SearchBudget_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace sudoku {
+
+// Outcome of one resumable search step.
+enum class SearchStatus : uint8_t
+{
+    Found, // A solution is in the engine; resuming looks for the next one.
+    Exhausted, // The search is complete: no further solutions.
+    BudgetExhausted, // Out of nodes or time; resuming continues where it stopped.
+    Cancelled, // The token was cancelled; resuming continues where it stopped.
+};
+
+// Set from any thread to stop searches that watch it.
+class CancellationToken
+{
+public:
+    void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+    void reset() { _cancelled.store(false, std::memory_order_relaxed); }
+    bool isCancelled() const { return _cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> _cancelled{false};
+};
+
+// Limits for one resume() call. The default budget is unlimited.
+struct SearchBudget
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Search nodes the call may visit; 0 for no limit.
+    uint64_t maxNodes = 0;
+    std::optional<Clock::time_point> deadline;
+    const CancellationToken* cancellation = nullptr;
+
+    // The clock and the token are checked once per this many nodes, so a
+    // stop lands within microseconds without a clock read per node.
+    static constexpr uint64_t kCheckInterval = 64;
+
+    static SearchBudget nodes(uint64_t count)
+    {
+        SearchBudget budget;
+        budget.maxNodes = count;
+        return budget;
+    }
+
+    static SearchBudget within(Clock::duration duration)
+    {
+        SearchBudget budget;
+        budget.deadline = Clock::now() + duration;
+        return budget;
+    }
+};
+
+} // namespace sudoku
+
+#endif /* SearchBudget_h */
@@ -0,0 +1,92 @@
+#ifndef SearchStats_h
+#define SearchStats_h
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+namespace sudoku {
+
+// Building with SUDOKU_NO_SEARCH_STATS defined (the SUDOKU_SEARCH_STATS=OFF
+// CMake option) turns every record call below into nothing, so the solvers'
+// hot loops are the same as if they had never been instrumented.
+#ifdef SUDOKU_NO_SEARCH_STATS
+inline constexpr bool kSearchStatsEnabled = false;
+#else
+inline constexpr bool kSearchStatsEnabled = true;
+#endif
+
+// What a solve or count spent its time on. Filled in by an engine only while
+// a SearchStats is attached to it.
+struct SearchStats
+{
+    // The widest branch any supported board can have (25x25).
+    static constexpr unsigned int kMaxBranching = 25;
+
+    // Search nodes entered, as counted by the engines' nodes().
+    uint64_t nodes = 0;
+    // Branches that were undone without yielding a solution.
+    uint64_t backtracks = 0;
+    // Runs of the engine's single propagation (none for DLX).
+    uint64_t propagations = 0;
+    // Cells (DLX: columns) inspected while choosing where to branch. The
+    // bitboard engine chooses with whole-board operations and counts one.
+    uint64_t scannedCells = 0;
+    // Deepest chain of branching decisions; 0 when propagation alone solves.
+    unsigned int maxDepth = 0;
+    // branching[n]: nodes that branched n ways.
+    std::array<uint64_t, kMaxBranching + 1> branching{};
+
+    void reset() { *this = SearchStats{}; }
+    void merge(const SearchStats& other);
+    // Total nodes that branched, and their mean branch count.
+    uint64_t branchingNodes() const;
+    double averageBranching() const;
+};
+
+// One-line summary: nodes, backtracks, propagations, depth, scans and the
+// non-zero histogram entries as "ways:nodes".
+std::ostream& operator<<(std::ostream& os, const SearchStats& stats);
+
+inline bool isCollecting(const SearchStats* stats)
+{
+    return kSearchStatsEnabled && stats != nullptr;
+}
+
+inline void recordNode(SearchStats* stats, unsigned int depth)
+{
+    if(isCollecting(stats))
+    {
+        ++stats->nodes;
+        stats->maxDepth = std::max(stats->maxDepth, depth);
+    }
+}
+
+inline void recordBranch(SearchStats* stats, unsigned int ways)
+{
+    if(isCollecting(stats))
+        ++stats->branching[std::min(ways, SearchStats::kMaxBranching)];
+}
+
+inline void recordBacktrack(SearchStats* stats)
+{
+    if(isCollecting(stats))
+        ++stats->backtracks;
+}
+
+inline void recordPropagation(SearchStats* stats)
+{
+    if(isCollecting(stats))
+        ++stats->propagations;
+}
+
+inline void recordScan(SearchStats* stats, unsigned int cells)
+{
+    if(isCollecting(stats))
+        stats->scannedCells += cells;
+}
+
+} // namespace sudoku
+
+#endif /* SearchStats_h */
@@ -0,0 +1,133 @@
+#ifndef Server_h
+#define Server_h
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+#include "SolveCache.h"
+#include "Solver.h"
+
+namespace sudoku {
+
+// Long-running 9x9 request server. Requests and responses are single lines:
+//
+//   generate [clues N | difficulty D] [seed N] [solution]
+//   solve PUZZLE
+//   count PUZZLE [limit N]
+//   validate PUZZLE
+//
+// Answers start with "ok " followed by the board, the solution, the count or
+// unique/multiple/unsolvable, or are "error <reason>" ("error timeout" when
+// a search outlives Options::searchTimeout). Each worker thread
+// keeps one board for the server's lifetime, so a request pays for neither
+// board construction nor seeding. Requests from one connection are handed to
+// the workers as soon as they are read and answered in the order they
+// arrived, so clients may pipeline any number of them.
+class RequestServer
+{
+public:
+    struct Options
+    {
+        unsigned int threads = 1;
+        SolverBackend backend = SolverBackend::Mrv;
+        // Result cache for solve and validate; 0 disables it.
+        std::size_t cacheSize = 0;
+        // Seeds generate requests without a seed of their own, together
+        // with a per-server request counter.
+        uint64_t masterSeed = 0;
+        // Longest search a solve, count or validate request may run; zero
+        // for no limit. Limited searches use the resumable MRV engine
+        // whatever the backend, so one pathological puzzle cannot hold a
+        // worker.
+        std::chrono::microseconds searchTimeout{0};
+        // Socket connections served at once; further clients wait in the
+        // listen backlog until one ends.
+        std::size_t maxConnections = 64;
+    };
+
+    explicit RequestServer(const Options& options);
+    ~RequestServer();
+
+    RequestServer(const RequestServer&) = delete;
+    RequestServer& operator=(const RequestServer&) = delete;
+
+    unsigned int size() const;
+
+    // Answers one request on the given worker's board, without the newline.
+    std::string handle(const std::string& request, unsigned int worker);
+
+    // Serves requests read from input until end of input, writing each
+    // answer to output. Returns after every answer has been written.
+    void serve(std::istream& input, std::ostream& output);
+
+    // Listens on a Unix domain socket at path (replacing a stale socket
+    // there) and serves each connection as above, until stop() is called.
+    // Returns false when path holds anything but a socket, when the socket
+    // cannot be set up, or on platforms without Unix sockets.
+    bool serveUnixSocket(const std::string& path);
+    void stop();
+
+private:
+    // Per-connection ordering of answers.
+    class Session;
+
+    struct Job
+    {
+        Session* session = nullptr;
+        uint64_t sequence = 0;
+        std::string request;
+    };
+
+    void workerLoop(unsigned int worker);
+    void submit(Session& session, std::string request);
+    void serveLines(const std::function<bool(std::string&)>& readLine,
+                    const std::function<void(const std::string&)>& write);
+
+    std::string generate(const std::vector<std::string>& words, Board& board);
+    std::string solve(const std::vector<std::string>& words, Board& board, unsigned int worker);
+    std::string count(const std::vector<std::string>& words, Board& board, unsigned int worker);
+    std::string validate(const std::vector<std::string>& words, Board& board, unsigned int worker);
+    // Looks for up to limit solutions on the worker's resumable solver and
+    // keeps the first. False when the search timed out.
+    bool searchWithin(const Grid& puzzle, uint64_t limit, unsigned int worker, uint64_t& found, Grid& solution);
+    // Solution and status under the search timeout, through the cache when
+    // there is one. False when the search timed out.
+    bool settleWithin(const Grid& puzzle, unsigned int worker, SolveResult& result);
+
+    Options _options;
+    std::vector<Board> _boards;
+    std::vector<Solver> _solvers;
+    std::unique_ptr<SolveCache> _cache;
+    std::atomic<uint64_t> _generated{0};
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::deque<Job> _jobs;
+    bool _stopping = false;
+    std::vector<std::thread> _threads;
+
+    // Connected sockets, guarded by _mutex, so stop() can end their reads
+    // and writes.
+    std::vector<int> _clients;
+    // Ids of connection threads that have ended and wait to be joined.
+    std::vector<uint64_t> _finishedConnections;
+    std::condition_variable _connectionDone;
+    std::atomic<int> _listener{-1};
+    std::atomic<bool> _listening{false};
+};
+
+} // namespace sudoku
+
+#endif /* Server_h */
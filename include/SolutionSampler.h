@@ -0,0 +1,78 @@
+#ifndef SolutionSampler_h
+#define SolutionSampler_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Board.h"
+#include "Canonical.h"
+#include "Grid.h"
+#include "Random.h"
+
+namespace sudoku {
+
+// The symmetry-group element picked by one 64-bit random word, read as a
+// mixed-radix number: transposition, band and stack order, the order of the
+// rows in each band and of the columns in each stack, and a relabelling of
+// the nine digits. The 2 * 6^8 * 9! elements need 41 bits, so taking the
+// digits modulo each radix leaves a bias below 2^-23.
+GridTransform transformFromWord(uint64_t word);
+
+// Draws solved 9x9 grids by applying random symmetry transforms to a pool of
+// seed grids made by the randomized search, instead of searching for each
+// grid. Every transform maps a solution to a solution, so the output is
+// always valid, but grids drawn from the same seed are equivalent under
+// symmetry; fresh search-generated seeds replace pool entries at a set rate
+// to keep mixing in new equivalence classes. Deterministic for a given seed
+// and options.
+class SolutionSampler
+{
+public:
+    struct Options
+    {
+        // Seed grids to transform; at least one.
+        std::size_t poolSize = 64;
+        // Replace the oldest seed with a freshly searched one before every
+        // freshInterval-th grid; 0 keeps the first pool for good.
+        uint64_t freshInterval = 0;
+        SolverBackend backend = SolverBackend::Bitboard;
+    };
+
+    explicit SolutionSampler(uint32_t seed);
+    SolutionSampler(uint32_t seed, const Options& options);
+
+    // Writes the next grid.
+    void next(Grid& grid);
+    // Writes one grid into each element of grids.
+    void fill(std::span<Grid> grids);
+
+    // Seed grids searched so far, the initial pool included.
+    uint64_t searchedSeeds() const { return _searchedSeeds; }
+    std::size_t poolSize() const { return _pool.size() / 2; }
+
+private:
+    // A grid as nine rows padded to 16 bytes, the layout the byte-shuffle
+    // path loads a row from.
+    struct alignas(16) PaddedGrid
+    {
+        std::array<std::array<uint8_t, 16>, 9> rows{};
+    };
+
+    void searchSeed(std::size_t slot);
+
+    Options _options;
+    RandomEngine _rng;
+    Board _board;
+    // Each seed twice, as searched and transposed, so a transposing
+    // transform costs nothing when it is applied.
+    std::vector<PaddedGrid> _pool;
+    std::size_t _oldestSeed = 0;
+    uint64_t _sinceFresh = 0;
+    uint64_t _searchedSeeds = 0;
+};
+
+} // namespace sudoku
+
+#endif /* SolutionSampler_h */
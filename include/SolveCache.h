@@ -0,0 +1,82 @@
+#ifndef SolveCache_h
+#define SolveCache_h
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Board.h"
+#include "Canonical.h"
+
+namespace sudoku {
+
+enum class SolveStatus : uint8_t
+{
+    Unsolvable,
+    Unique,
+    Multiple
+};
+
+struct SolveResult
+{
+    SolveStatus status = SolveStatus::Unsolvable;
+    // A solution of the puzzle; all zero when it has none.
+    Grid solution{};
+};
+
+struct SolveCacheCounters
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+// Bounded map from canonical 9x9 puzzles to their solution and uniqueness
+// status, so a puzzle seen before in any orientation, band order or digit
+// labelling is answered without a search. Eviction follows the CLOCK
+// algorithm: a hit only sets the entry's reference bit, and the hand gives
+// each referenced entry a second chance before evicting it. Safe to use from
+// several threads; searches on a miss run outside the lock.
+class SolveCache
+{
+public:
+    // A capacity of 0 disables caching; every call then counts as a miss.
+    explicit SolveCache(std::size_t capacity);
+
+    // Answers for puzzle from the cache or, on a miss, by searching its
+    // canonical form on board for up to two solutions and storing the
+    // result. The solution is mapped back to the puzzle's own frame. For
+    // puzzles with several solutions it is one of them, the same for every
+    // equivalent puzzle.
+    SolveResult solve(const Grid& puzzle, Board& board, SolverBackend backend = SolverBackend::Mrv);
+
+    // Results in the canonical frame. lookup counts a hit or a miss.
+    bool lookup(const CanonicalKey& key, SolveResult& result);
+    void insert(const CanonicalKey& key, const SolveResult& result);
+
+    SolveCacheCounters counters() const;
+    std::size_t size() const;
+    std::size_t capacity() const { return _capacity; }
+    // Drops every entry; the counters are kept.
+    void clear();
+
+private:
+    struct Slot
+    {
+        CanonicalKey key{};
+        SolveResult result;
+        bool referenced = false;
+    };
+
+    const std::size_t _capacity;
+    mutable std::mutex _mutex;
+    std::vector<Slot> _slots;
+    std::unordered_map<CanonicalKey, std::size_t, CanonicalKeyHash> _index;
+    std::size_t _hand = 0;
+    SolveCacheCounters _counters;
+};
+
+} // namespace sudoku
+
+#endif /* SolveCache_h */
@@ -0,0 +1,182 @@
+#ifndef Solver_h
+#define Solver_h
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "Grid.h"
+#include "Random.h"
+#include "SearchBudget.h"
+#include "SearchStats.h"
+
+namespace sudoku {
+
+// Backtracking search over a grid of Box x Box boxes. The solver keeps its
+// state between search nodes: a candidate mask per cell, a compact list of the
+// empty cells and a trail of eliminations. Assigning a cell only touches its
+// peers (20 on a 9x9 board) and undoing it replays the trail, so no node
+// rescans the whole grid.
+template <unsigned int Box>
+class BasicSolver
+{
+public:
+    using Shape = Geometry<Box>;
+    using Mask = typename Shape::Mask;
+    using Cell = typename Shape::Cell;
+    using GridType = BasicGrid<Box>;
+
+    static constexpr unsigned int kDimension = Shape::kDimension;
+    static constexpr unsigned int kCells = Shape::kCells;
+
+    // Loads givens (0 = empty). Returns false for out-of-range or conflicting digits.
+    bool load(const GridType& cells);
+    void store(GridType& cells) const { cells = _values; }
+
+    // Finds the first solution, trying candidates in random order when an
+    // engine is given. On success the solution is left in the solver. Built
+    // for Xoshiro256PlusPlus and Pcg32.
+    template <typename Rng = RandomEngine>
+    bool solve(Rng* rng = nullptr);
+    // Counts solutions up to limit. The solver is left in its loaded state.
+    uint64_t count(uint64_t limit);
+    // Like count(), but adds solutions to sharedTotal as they are found (in
+    // small batches) and stops once sharedTotal reaches limit, so solvers on
+    // several threads can work towards one limit. Returns the local count.
+    uint64_t countShared(std::atomic<uint64_t>& sharedTotal, uint64_t limit);
+    // Passes each solution to visit as the search reaches it and stops as soon
+    // as visit returns false, so no search is spent past the last solution
+    // wanted. Returns the number of solutions visited. The solver is left in
+    // its loaded state.
+    uint64_t enumerate(const BasicSolutionVisitor<Box>& visit);
+
+    // Iterative search with an explicit stack, for callers that must bound
+    // the time spent on one puzzle. beginSearch() starts over on the loaded
+    // puzzle; each resume() runs until the next solution (left in the solver
+    // for store()), the end of the search, or the budget or cancellation
+    // stops it. A stopped search keeps its whole state in the solver, so a
+    // later resume() continues it without repeating work, on this or another
+    // thread, and a copy of the solver resumes independently. Candidates are
+    // tried in digit order, so the solutions come in the order count() and
+    // enumerate() find them. Any other search or edit abandons it.
+    void beginSearch();
+    SearchStatus resume(const SearchBudget& budget = {});
+    // Solutions reported by resume() since beginSearch().
+    uint64_t solutionsFound() const { return _solutionsFound; }
+
+    // True when some solution of the loaded puzzle has a digit other than
+    // value at cell. If the puzzle with value placed at cell has exactly one
+    // solution, this tells whether clearing that cell keeps the solution
+    // unique, without counting from scratch. The solver is left in its loaded state.
+    bool hasSolutionExcluding(unsigned int cell, unsigned int value);
+    // Edit the loaded puzzle in place, updating only the cell and its peers,
+    // so a generator can try one removal after another without reloading.
+    void removeGiven(unsigned int cell);
+    void restoreGiven(unsigned int cell, unsigned int value);
+
+    void setPropagationEnabled(bool enabled) { _propagationEnabled = enabled; }
+    bool isPropagationEnabled() const { return _propagationEnabled; }
+    uint64_t nodes() const { return _nodes; }
+    // Later searches add to stats until it is detached with nullptr.
+    void setSearchStats(SearchStats* stats) { _stats = stats; }
+
+private:
+    struct Assignment
+    {
+        Cell cell;
+        Mask savedCandidates;
+        uint16_t trailStart;
+    };
+
+    // One branching cell of the resumable search: the candidates not tried
+    // yet and the assignment count to undo to before trying the next.
+    struct Frame
+    {
+        Cell cell;
+        Mask remaining;
+        uint16_t mark;
+    };
+
+    enum class Phase : uint8_t
+    {
+        Idle,
+        Start,
+        Running,
+        Finished,
+    };
+
+    enum class Expansion : uint8_t
+    {
+        DeadEnd,
+        Solution,
+        Branch,
+    };
+
+    bool assign(unsigned int cell, unsigned int value);
+    // Rolls assignments back to the count mark. Givens are loaded into the
+    // masks rather than assigned, so undo(0) restores the loaded puzzle.
+    void undo(unsigned int mark);
+    bool propagate();
+    bool findBestCell(unsigned int& bestCell, Mask& bestCandidates) const;
+    void queueNakedSingles();
+    Mask candidatesFromUnits(unsigned int cell) const;
+    template <typename Rng>
+    bool search(Rng* rng, unsigned int depth);
+    uint64_t countImpl(uint64_t limit, unsigned int depth);
+    // Returns false once visit has asked to stop.
+    bool enumerateImpl(const BasicSolutionVisitor<Box>& visit, uint64_t& visited, unsigned int depth);
+    // Visits the current node of the resumable search, pushing a frame when it branches.
+    Expansion expand();
+    SearchStatus finishSearch();
+    void publish();
+
+    GridType _values{};
+    std::array<Mask, kCells> _candidates{};
+    std::array<Cell, kCells> _empty{};
+    std::array<Cell, kCells> _emptyPosition{};
+    unsigned int _emptyCount = 0;
+
+    // Digits placed by the givens in each row, column and box.
+    std::array<Mask, kDimension> _rowMasks{};
+    std::array<Mask, kDimension> _columnMasks{};
+    std::array<Mask, kDimension> _boxMasks{};
+
+    // Along one search path each cell loses each candidate at most once.
+    static_assert(kCells * kDimension <= UINT16_MAX, "Trail positions are stored as uint16_t");
+    std::array<Cell, kCells * kDimension> _trail{};
+    unsigned int _trailSize = 0;
+    std::array<Assignment, kCells> _assignments{};
+    unsigned int _assignmentCount = 0;
+
+    // One spare slot: assign() stores unconditionally before bumping the count.
+    std::array<Cell, kCells + 1> _pending{};
+    unsigned int _pendingCount = 0;
+
+    bool _consistent = true;
+    bool _propagationEnabled = true;
+    uint64_t _nodes = 0;
+    SearchStats* _stats = nullptr;
+
+    // Each frame fills at least one cell.
+    std::array<Frame, kCells> _frames{};
+    unsigned int _frameCount = 0;
+    Phase _phase = Phase::Idle;
+    uint64_t _solutionsFound = 0;
+
+    // Set only during countShared().
+    static constexpr uint64_t kPublishInterval = 64;
+    static constexpr uint64_t kSharedCheckInterval = 1023;
+    std::atomic<uint64_t>* _sharedTotal = nullptr;
+    uint64_t _sharedLimit = 0;
+    uint64_t _unpublished = 0;
+    bool _stopped = false;
+};
+
+extern template class BasicSolver<3>;
+extern template class BasicSolver<4>;
+extern template class BasicSolver<5>;
+
+using Solver = BasicSolver<3>;
+
+} // namespace sudoku
+
+#endif /* Solver_h */
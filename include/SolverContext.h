@@ -0,0 +1,92 @@
+#ifndef SolverContext_h
+#define SolverContext_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include "BitboardSolver.h"
+#include "DlxSolver.h"
+#include "Grader.h"
+#include "Random.h"
+#include "SearchStats.h"
+#include "Solver.h"
+
+namespace sudoku {
+
+// Search engine used by a solve, count or generate call.
+enum class SolverBackend
+{
+    Mrv, // BasicSolver: MRV cell choice with naked/hidden single propagation.
+    Dlx, // BasicDlxSolver: exact cover with Dancing Links.
+    Bitboard, // BitboardSolver: SIMD per-digit bitboards (9x9 only; larger boards use Mrv).
+};
+
+// Everything a board searches with: the random engine (Rng, a small-state
+// generator from Random.h), one of each search engine with its preallocated
+// trail and stacks, and the grader. A context
+// takes kilobytes (tens of them for 25x25) and seeding the engine is not
+// free, so boards lease contexts from a small per-thread pool instead of
+// owning them: a board made per request reuses warm engines, and searches on
+// a pooled context allocate nothing.
+template <unsigned int Box, typename Rng = RandomEngine>
+class BasicSolverContext
+{
+public:
+    struct NoBitboardSolver {};
+    using BitboardEngine = std::conditional_t<Box == 3, BitboardSolver, NoBitboardSolver>;
+
+    // Seeds the engine from seed, or from std::random_device.
+    explicit BasicSolverContext(std::optional<uint32_t> seed = std::nullopt);
+
+    Rng& rng() { return _rng; }
+    BasicSolver<Box>& solver() { return _solver; }
+    // Builds its link matrix on first use only; pooling keeps it built.
+    BasicDlxSolver<Box>& dlxSolver() { return _dlxSolver; }
+    BitboardEngine& bitboardSolver() { return _bitboardSolver; }
+    BasicGrader<Box>& grader() { return _grader; }
+
+    // Records the engine of the latest search, whose nodes are reported.
+    void setLastBackend(SolverBackend backend) { _lastBackend = backend; }
+    uint64_t lastSearchNodes() const;
+    // Points every engine at stats (nullptr detaches them).
+    void setSearchStats(SearchStats* stats);
+
+    // Puts engine settings back to their defaults (propagation on, no
+    // stats) for a new lessee. The random engine keeps its state.
+    void resetSettings();
+
+    // An idle context from the calling thread's pool, or a new one, seeded
+    // from seed or else from a per-thread stream that reads
+    // std::random_device once per thread.
+    static std::unique_ptr<BasicSolverContext> acquire(std::optional<uint32_t> seed = std::nullopt);
+    // Parks context in the calling thread's pool; it is freed instead when
+    // the pool holds kPoolCapacity contexts already or the thread is exiting.
+    static void release(std::unique_ptr<BasicSolverContext> context);
+    // Idle contexts in the calling thread's pool.
+    static std::size_t pooled();
+
+    static constexpr std::size_t kPoolCapacity = 8;
+
+private:
+    Rng _rng;
+    BasicSolver<Box> _solver;
+    BasicDlxSolver<Box> _dlxSolver;
+    BitboardEngine _bitboardSolver;
+    BasicGrader<Box> _grader;
+    SolverBackend _lastBackend = SolverBackend::Mrv;
+};
+
+extern template class BasicSolverContext<3>;
+extern template class BasicSolverContext<4>;
+extern template class BasicSolverContext<5>;
+extern template class BasicSolverContext<3, Pcg32>;
+extern template class BasicSolverContext<4, Pcg32>;
+extern template class BasicSolverContext<5, Pcg32>;
+
+using SolverContext = BasicSolverContext<3>;
+
+} // namespace sudoku
+
+#endif /* SolverContext_h */
@@ -0,0 +1,51 @@
+#ifndef WorkerPool_h
+#define WorkerPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sudoku {
+
+// Fixed-size pool of worker threads. Each call to run() hands out item indices
+// to the workers and blocks until every item has been processed, so callers can
+// keep one reusable engine per worker index.
+class WorkerPool
+{
+public:
+    using Task = std::function<void(unsigned int worker, std::size_t item)>;
+
+    explicit WorkerPool(unsigned int threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned int size() const;
+    void run(std::size_t count, const Task& task);
+
+    static unsigned int defaultThreadCount();
+
+private:
+    void workerLoop(unsigned int worker);
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    const Task* _task = nullptr;
+    std::size_t _count = 0;
+    std::atomic<std::size_t> _next{0};
+    unsigned int _active = 0;
+    uint64_t _generation = 0;
+    bool _stopping = false;
+};
+
+} // namespace sudoku
+
+#endif /* WorkerPool_h */
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <bit>
+#include "BatchSolver.h"
+#include "GridTables.h"
+
+using namespace sudoku;
+
+namespace {
+
+// Digit d (1-9) is bit d - 1 of a lane's mask.
+constexpr uint16_t kAllDigits = 0x1FF;
+
+} // namespace
+
+BatchSolver::BatchSolver()
+    : _frames(kLanes * kCells)
+{
+}
+
+bool BatchSolver::start(unsigned int lane, const Grid& puzzle)
+{
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const unsigned int value = puzzle[cell];
+        if(value > kDimension)
+            return false;
+        // Conflicting givens are left for propagate() to find.
+        setCell(lane, cell, value == 0 ? kAllDigits : static_cast<uint16_t>(1u << (value - 1)));
+    }
+    _lanes[lane].depth = 0;
+    return true;
+}
+
+uint32_t BatchSolver::propagate()
+{
+    const LaneVector all = LaneVector::splat(kAllDigits);
+    LaneVector failed;
+    for(;;)
+    {
+        LaneVector changed;
+        for(const auto& unit : kGridTables<3>.units)
+        {
+            std::array<LaneVector, kDimension> masks;
+            std::array<LaneVector, kDimension> solved;
+            LaneVector once;
+            LaneVector twice;
+            LaneVector placed;
+            for(unsigned int i = 0; i < kDimension; ++i)
+            {
+                masks[i] = LaneVector::load(_masks[unit[i]].data());
+                solved[i] = masks[i].atMostOneBitLanes();
+                const LaneVector single = masks[i] & solved[i];
+                // The same digit placed twice, or a cell with no candidate.
+                failed |= (placed & single) | masks[i].zeroLanes();
+                placed |= single;
+                twice |= once & masks[i];
+                once |= masks[i];
+            }
+            // A digit with no place left in the unit.
+            failed |= andNot(all, once);
+
+            // Solved cells keep their digit; open cells lose the placed
+            // digits, and a cell holding a digit found nowhere else in the
+            // unit is narrowed to it.
+            const LaneVector hidden = andNot(once, twice);
+            for(unsigned int i = 0; i < kDimension; ++i)
+            {
+                LaneVector next = select(solved[i], masks[i], andNot(masks[i], placed));
+                const LaneVector forced = next & hidden;
+                next = select(forced.zeroLanes(), next, forced);
+                changed |= andNot(masks[i], next);
+                next.store(_masks[unit[i]].data());
+            }
+        }
+        // Lanes that already failed are about to backtrack, so their
+        // changes do not keep the others waiting.
+        if(andNot(changed, failed).isEmpty())
+            return failed.laneBits();
+    }
+}
+
+uint32_t BatchSolver::chooseCells(LaneMasks& cells) const
+{
+    const LaneVector none = LaneVector::splat(kDimension + 1);
+    const LaneVector two = LaneVector::splat(2);
+    LaneVector best = none;
+    LaneVector bestCell;
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const LaneVector count = LaneVector::load(_masks[cell].data()).popcount();
+        const LaneVector better = andNot(less(count, best), less(count, two));
+        best = select(better, count, best);
+        bestCell = select(better, LaneVector::splat(static_cast<uint16_t>(cell)), bestCell);
+    }
+    bestCell.store(cells.data());
+    return equal(best, none).laneBits();
+}
+
+void BatchSolver::branch(unsigned int lane, unsigned int cell)
+{
+    Frame& frame = _frames[lane * kCells + _lanes[lane].depth++];
+    for(unsigned int index = 0; index < kCells; ++index)
+        frame.masks[index] = _masks[index][lane];
+
+    // The MRV cell has at least two candidates, so the frame has a digit left.
+    const uint16_t mask = _masks[cell][lane];
+    const uint16_t first = static_cast<uint16_t>(mask & -mask);
+    frame.cell = static_cast<uint8_t>(cell);
+    frame.remaining = static_cast<uint16_t>(mask & ~first);
+    setCell(lane, cell, first);
+}
+
+bool BatchSolver::backtrack(unsigned int lane)
+{
+    Lane& state = _lanes[lane];
+    if(state.depth == 0)
+        return false;
+
+    Frame& frame = _frames[lane * kCells + state.depth - 1];
+    for(unsigned int index = 0; index < kCells; ++index)
+        _masks[index][lane] = frame.masks[index];
+
+    const uint16_t next = static_cast<uint16_t>(frame.remaining & -frame.remaining);
+    frame.remaining = static_cast<uint16_t>(frame.remaining & ~next);
+    setCell(lane, frame.cell, next);
+    // The last alternative needs no frame to come back to.
+    if(frame.remaining == 0)
+        --state.depth;
+    return true;
+}
+
+void BatchSolver::record(unsigned int lane, Grid& solution) const
+{
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+        solution[cell] = static_cast<uint8_t>(std::countr_zero(_masks[cell][lane]) + 1);
+}
+
+void BatchSolver::solve(std::span<const Grid> puzzles, std::span<BatchOutcome> outcomes, uint32_t limit)
+{
+    _nodes = 0;
+    std::fill(outcomes.begin(), outcomes.begin() + puzzles.size(), BatchOutcome{});
+    if(limit == 0)
+        return;
+
+    // Gives the lane the next valid puzzle, or parks it with empty masks,
+    // which propagate() leaves alone.
+    std::size_t next = 0;
+    auto refill = [&](unsigned int lane) {
+        Lane& state = _lanes[lane];
+        while(next < puzzles.size())
+        {
+            const std::size_t index = next++;
+            if(start(lane, puzzles[index]))
+            {
+                state.puzzle = index;
+                state.solutions = 0;
+                state.active = true;
+                return;
+            }
+        }
+        state.active = false;
+        for(LaneMasks& masks : _masks)
+            masks[lane] = 0;
+    };
+
+    unsigned int active = 0;
+    for(unsigned int lane = 0; lane < kLanes; ++lane)
+    {
+        refill(lane);
+        active += _lanes[lane].active ? 1 : 0;
+    }
+
+    LaneMasks cells{};
+    while(active != 0)
+    {
+        const uint32_t failed = propagate();
+        const uint32_t solved = chooseCells(cells);
+
+        for(unsigned int lane = 0; lane < kLanes; ++lane)
+        {
+            Lane& state = _lanes[lane];
+            if(!state.active)
+                continue;
+            ++_nodes;
+
+            const uint32_t bit = 1u << lane;
+            bool searching = true;
+            if((failed & bit) != 0)
+            {
+                searching = backtrack(lane);
+            }
+            else if((solved & bit) != 0)
+            {
+                if(state.solutions++ == 0)
+                    record(lane, outcomes[state.puzzle].solution);
+                searching = state.solutions < limit && backtrack(lane);
+            }
+            else
+            {
+                branch(lane, cells[lane]);
+            }
+
+            if(!searching)
+            {
+                outcomes[state.puzzle].solutions = state.solutions;
+                refill(lane);
+                active -= state.active ? 0 : 1;
+            }
+        }
+    }
+}
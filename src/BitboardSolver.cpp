@@ -0,0 +1,392 @@
+#include <bit>
+#include "BitboardSolver.h"
+#include "GridTables.h"
+
+using namespace sudoku;
+
+namespace {
+
+struct BitboardTables
+{
+    std::array<BitboardLanes, 81> cells{};
+    std::array<BitboardLanes, 81> peers{};
+};
+
+constexpr BitboardTables makeBitboardTables()
+{
+    BitboardTables tables{};
+    for(unsigned int cell = 0; cell < 81; ++cell)
+    {
+        tables.cells[cell][cell / 27] = 1u << (cell % 27);
+        for(unsigned int peer : kGridTables<3>.peers[cell])
+            tables.peers[cell][peer / 27] |= 1u << (peer % 27);
+    }
+    return tables;
+}
+
+constexpr BitboardTables kBitboardTables = makeBitboardTables();
+
+constexpr uint32_t kBandCells = 0x7FFFFFF;
+constexpr uint32_t kRowCells = 0x1FF;
+// The three cells of each row of the band's first box.
+constexpr uint32_t kBoxCells = 0x7 | (0x7 << 9) | (0x7 << 18);
+
+inline Bitboard cellBit(unsigned int cell)
+{
+    return Bitboard::load(kBitboardTables.cells[cell]);
+}
+
+// Bits of x in the bands where x has exactly one bit; fails if any band is empty.
+inline bool keepSingleBands(const Bitboard& x, Bitboard& singles)
+{
+    if(x.emptyBands() != 0)
+        return false;
+    singles = x & x.atMostOneBitLanes();
+    return true;
+}
+
+} // namespace
+
+void BitboardSolver::State::assign(unsigned int cell, unsigned int digit)
+{
+    const Bitboard bit = cellBit(cell);
+    for(Bitboard& board : digits)
+        board = andNot(board, bit);
+    digits[digit] = andNot(digits[digit], Bitboard::load(kBitboardTables.peers[cell])) | bit;
+    unsolved = andNot(unsolved, bit);
+}
+
+bool BitboardSolver::State::placeHiddenSingles(unsigned int digit, bool& placed)
+{
+    const Bitboard board = digits[digit];
+    const Bitboard rowMask = Bitboard::bands(kRowCells);
+
+    // Each band of the digit's board split into its three rows.
+    const Bitboard row0 = board & rowMask;
+    const Bitboard row1 = board.shiftRight<9>() & rowMask;
+    const Bitboard row2 = board.shiftRight<18>() & rowMask;
+
+    Bitboard single0;
+    Bitboard single1;
+    Bitboard single2;
+    if(!keepSingleBands(row0, single0) || !keepSingleBands(row1, single1) || !keepSingleBands(row2, single2))
+        return false;
+    Bitboard hidden = single0 | single1.shiftLeft<9>() | single2.shiftLeft<18>();
+
+    if(!keepSingleBands(board & Bitboard::bands(kBoxCells), single0)
+       || !keepSingleBands(board & Bitboard::bands(kBoxCells << 3), single1)
+       || !keepSingleBands(board & Bitboard::bands(kBoxCells << 6), single2))
+        return false;
+    hidden |= single0 | single1 | single2;
+
+    // Columns: count the nine rows with once/twice masks, first within each
+    // band and then across the bands by rotating lanes.
+    const Bitboard bandOnce = row0 | row1 | row2;
+    const Bitboard bandTwice = (row0 & row1) | (row0 & row2) | (row1 & row2);
+    const Bitboard onceNext = bandOnce.rotateBands();
+    const Bitboard onceLast = bandOnce.rotateBandsTwice();
+    const Bitboard once = bandOnce | onceNext | onceLast;
+    const Bitboard twice = bandTwice | bandTwice.rotateBands() | bandTwice.rotateBandsTwice()
+        | (bandOnce & onceNext) | (bandOnce & onceLast) | (onceNext & onceLast);
+    if(!andNot(rowMask, once).isEmpty())
+        return false;
+    const Bitboard columns = andNot(once, twice);
+    hidden |= board & (columns | columns.shiftLeft<9>() | columns.shiftLeft<18>());
+
+    hidden &= unsolved;
+    if(hidden.isEmpty())
+        return true;
+
+    hidden.forEachCell([&](unsigned int cell) {
+        // An earlier single of this pass may have taken the cell or the digit;
+        // the next pass then reports the contradiction if there is one.
+        const Bitboard bit = cellBit(cell);
+        if(!digits[digit].intersects(bit) || !unsolved.intersects(bit))
+            return;
+        assign(cell, digit);
+        placed = true;
+    });
+    return true;
+}
+
+bool BitboardSolver::State::propagate()
+{
+    for(;;)
+    {
+        // Bit-sliced candidate counts: once has the cells with at least one
+        // candidate, twice those with at least two.
+        Bitboard once;
+        Bitboard twice;
+        for(const Bitboard& board : digits)
+        {
+            twice |= once & board;
+            once |= board;
+        }
+        if(!andNot(unsolved, once).isEmpty())
+            return false;
+
+        bool placed = false;
+        bool consistent = true;
+        andNot(unsolved, twice).forEachCell([&](unsigned int cell) {
+            const Bitboard bit = cellBit(cell);
+            if(!consistent || !unsolved.intersects(bit))
+                return;
+            for(unsigned int digit = 0; digit < kDimension; ++digit)
+            {
+                if(digits[digit].intersects(bit))
+                {
+                    assign(cell, digit);
+                    placed = true;
+                    return;
+                }
+            }
+            consistent = false;
+        });
+        if(!consistent)
+            return false;
+
+        for(unsigned int digit = 0; digit < kDimension; ++digit)
+        {
+            if(!placeHiddenSingles(digit, placed))
+                return false;
+        }
+
+        if(!placed)
+            return true;
+    }
+}
+
+unsigned int BitboardSolver::State::chooseCell() const
+{
+    // Cells with exactly two candidates, then three, then any open cell.
+    Bitboard atLeast1;
+    Bitboard atLeast2;
+    Bitboard atLeast3;
+    Bitboard atLeast4;
+    for(const Bitboard& board : digits)
+    {
+        atLeast4 |= atLeast3 & board;
+        atLeast3 |= atLeast2 & board;
+        atLeast2 |= atLeast1 & board;
+        atLeast1 |= board;
+    }
+
+    const Bitboard pairs = andNot(unsolved & atLeast2, atLeast3);
+    if(!pairs.isEmpty())
+        return pairs.firstCell();
+    const Bitboard triples = andNot(unsolved & atLeast3, atLeast4);
+    if(!triples.isEmpty())
+        return triples.firstCell();
+    return unsolved.firstCell();
+}
+
+bool BitboardSolver::load(const GridType& cells)
+{
+    _values = cells;
+    _nodes = 0;
+    _consistent = false;
+
+    const Bitboard all = Bitboard::bands(kBandCells);
+    _root.digits.fill(all);
+    _root.unsolved = all;
+
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const unsigned int value = cells[cell];
+        if(value == 0)
+            continue;
+        // A digit already removed from the cell means a peer holds it.
+        if(value > kDimension || !_root.digits[value - 1].intersects(cellBit(cell)))
+            return false;
+        _root.assign(cell, value - 1);
+    }
+
+    _consistent = true;
+    return true;
+}
+
+void BitboardSolver::record(const State& state)
+{
+    for(unsigned int digit = 0; digit < kDimension; ++digit)
+    {
+        state.digits[digit].forEachCell([&](unsigned int cell) {
+            _values[cell] = static_cast<uint8_t>(digit + 1);
+        });
+    }
+}
+
+bool BitboardSolver::propagate(State& state)
+{
+    recordPropagation(_stats);
+    return state.propagate();
+}
+
+template <typename Rng>
+bool BitboardSolver::search(State& state, Rng* rng, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    if(state.unsolved.isEmpty())
+    {
+        record(state);
+        return true;
+    }
+
+    const unsigned int cell = state.chooseCell();
+    recordScan(_stats, 1);
+    const Bitboard bit = cellBit(cell);
+    uint32_t candidates = 0;
+    for(unsigned int digit = 0; digit < kDimension; ++digit)
+    {
+        if(state.digits[digit].intersects(bit))
+            candidates |= 1u << digit;
+    }
+
+    recordBranch(_stats, static_cast<unsigned int>(std::popcount(candidates)));
+    // With an engine, digits are drawn from the mask in random order.
+    while(candidates != 0)
+    {
+        const unsigned int digit = rng != nullptr ? randomSetBit(*rng, candidates)
+                                                  : static_cast<unsigned int>(std::countr_zero(candidates));
+        candidates &= ~(1u << digit);
+        State child = state;
+        child.assign(cell, digit);
+        if(propagate(child) && search(child, rng, depth + 1))
+            return true;
+        recordBacktrack(_stats);
+    }
+
+    return false;
+}
+
+template <typename Rng>
+bool BitboardSolver::solve(Rng* rng)
+{
+    if(!_consistent)
+        return false;
+
+    State state = _root;
+    return propagate(state) && search(state, rng, 0);
+}
+
+uint64_t BitboardSolver::countImpl(State& state, uint64_t limit, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    if(state.unsolved.isEmpty())
+        return 1;
+
+    const unsigned int cell = state.chooseCell();
+    recordScan(_stats, 1);
+    const Bitboard bit = cellBit(cell);
+    if(isCollecting(_stats))
+    {
+        unsigned int ways = 0;
+        for(unsigned int digit = 0; digit < kDimension; ++digit)
+            ways += state.digits[digit].intersects(bit) ? 1 : 0;
+        recordBranch(_stats, ways);
+    }
+
+    uint64_t total = 0;
+    for(unsigned int digit = 0; digit < kDimension && total < limit; ++digit)
+    {
+        if(!state.digits[digit].intersects(bit))
+            continue;
+
+        State child = state;
+        child.assign(cell, digit);
+        uint64_t found = 0;
+        if(propagate(child))
+            found = countImpl(child, limit - total, depth + 1);
+        if(found == 0)
+            recordBacktrack(_stats);
+        total += found;
+    }
+
+    return total;
+}
+
+uint64_t BitboardSolver::count(uint64_t limit)
+{
+    if(limit == 0 || !_consistent)
+        return 0;
+
+    State state = _root;
+    if(!propagate(state))
+        return 0;
+
+    return countImpl(state, limit, 0);
+}
+
+bool BitboardSolver::enumerateImpl(State& state, const SolutionVisitor& visit, uint64_t& visited, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    if(state.unsolved.isEmpty())
+    {
+        // The state holds only bitboards, so the grid is built for the visitor.
+        record(state);
+        ++visited;
+        return visit(_values);
+    }
+
+    const unsigned int cell = state.chooseCell();
+    recordScan(_stats, 1);
+    const Bitboard bit = cellBit(cell);
+    if(isCollecting(_stats))
+    {
+        unsigned int ways = 0;
+        for(unsigned int digit = 0; digit < kDimension; ++digit)
+            ways += state.digits[digit].intersects(bit) ? 1 : 0;
+        recordBranch(_stats, ways);
+    }
+
+    for(unsigned int digit = 0; digit < kDimension; ++digit)
+    {
+        if(!state.digits[digit].intersects(bit))
+            continue;
+
+        State child = state;
+        child.assign(cell, digit);
+        const uint64_t before = visited;
+        const bool more = !propagate(child) || enumerateImpl(child, visit, visited, depth + 1);
+        if(visited == before)
+            recordBacktrack(_stats);
+        if(!more)
+            return false;
+    }
+
+    return true;
+}
+
+uint64_t BitboardSolver::enumerate(const SolutionVisitor& visit)
+{
+    if(!_consistent)
+        return 0;
+
+    // Solutions are built in _values, which otherwise holds the givens.
+    const GridType givens = _values;
+    State state = _root;
+    uint64_t visited = 0;
+    if(propagate(state))
+        enumerateImpl(state, visit, visited, 0);
+    _values = givens;
+    return visited;
+}
+
+bool BitboardSolver::hasSolutionExcluding(unsigned int cell, unsigned int value)
+{
+    const Bitboard bit = cellBit(cell);
+    if(!_consistent || value == 0 || value > kDimension || !_root.unsolved.intersects(bit))
+        return false;
+
+    State state = _root;
+    state.digits[value - 1] = andNot(state.digits[value - 1], bit);
+    return propagate(state) && countImpl(state, 1, 0) > 0;
+}
+
+template bool BitboardSolver::solve(Xoshiro256PlusPlus*);
+template bool BitboardSolver::solve(Pcg32*);
@@ -8,374 +8,454 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <iomanip>
 #include <numeric>
-#include <random>
+#include <utility>
 #include "Board.h"
 
 using namespace sudoku;
 
 namespace {
 
-constexpr unsigned int kBoardCells = Board::BOARD_DIMENSION * Board::BOARD_DIMENSION;
-constexpr unsigned int kBoxDimension = 3;
-constexpr uint16_t kAllDigitsMask = static_cast<uint16_t>((1u << (Board::BOARD_DIMENSION + 1)) - 2u);
+// Local repair steps allowed per clue still above the target.
+constexpr unsigned int kRepairStepsPerClue = 256;
 
+template <unsigned int Box>
 inline unsigned int rowForIndex(unsigned int index)
 {
-    return index / Board::BOARD_DIMENSION;
+    return index / Geometry<Box>::kDimension;
 }
 
+template <unsigned int Box>
 inline unsigned int columnForIndex(unsigned int index)
 {
-    return index % Board::BOARD_DIMENSION;
-}
-
-inline unsigned int boxForRowColumn(unsigned int row, unsigned int column)
-{
-    return (row / kBoxDimension) * kBoxDimension + (column / kBoxDimension);
+    return index % Geometry<Box>::kDimension;
 }
 
 } // namespace
 
-Board::Board(std::optional<uint32_t> seed)
-    : _boardData(kBoardCells, 0),
-      _workBuffer(kBoardCells, 0),
-      _rng(seed.has_value() ? seed.value() : std::random_device{}())
+template <unsigned int Box, typename Rng>
+BasicBoard<Box, Rng>::BasicBoard(std::optional<uint32_t> seed)
+    : _context(BasicSolverContext<Box, Rng>::acquire(seed))
 {
 }
 
-Board::~Board()
+template <unsigned int Box, typename Rng>
+BasicBoard<Box, Rng>::BasicBoard(const BasicBoard& other)
+    : _boardData(other._boardData)
+    , _context(BasicSolverContext<Box, Rng>::acquire())
+    , _lastGenerationStats(other._lastGenerationStats)
+    , _lastSearchStats(other._lastSearchStats)
+    , _searchStatsEnabled(other._searchStatsEnabled)
 {
+    _context->rng() = other._context->rng();
+    _context->solver().setPropagationEnabled(other.isPropagationEnabled());
 }
 
-void Board::setSeed(uint32_t seed)
+template <unsigned int Box, typename Rng>
+BasicBoard<Box, Rng>::BasicBoard(BasicBoard&& other) noexcept
+    : _boardData(other._boardData)
+    , _context(std::exchange(other._context, BasicSolverContext<Box, Rng>::acquire()))
+    , _lastGenerationStats(other._lastGenerationStats)
+    , _lastSearchStats(other._lastSearchStats)
+    , _searchStatsEnabled(other._searchStatsEnabled)
 {
-    _rng.seed(seed);
 }
 
-bool Board::initializeMasks(const std::vector<unsigned int>& data,
-                            std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                            std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                            std::array<uint16_t, BOARD_DIMENSION>& boxMasks) const
+template <unsigned int Box, typename Rng>
+BasicBoard<Box, Rng>& BasicBoard<Box, Rng>::operator=(const BasicBoard& other)
 {
-    rowMasks.fill(0);
-    columnMasks.fill(0);
-    boxMasks.fill(0);
-
-    for(unsigned int index = 0; index < kBoardCells; ++index)
+    if(this != &other)
     {
-        const unsigned int value = data[index];
-        if(value == 0)
-            continue;
-        if(value > BOARD_DIMENSION)
-            return false;
-
-        const unsigned int row = rowForIndex(index);
-        const unsigned int column = columnForIndex(index);
-        const unsigned int box = boxForRowColumn(row, column);
-        const uint16_t bit = static_cast<uint16_t>(1u << value);
-
-        if((rowMasks[row] & bit) != 0 || (columnMasks[column] & bit) != 0 || (boxMasks[box] & bit) != 0)
-            return false;
-
-        rowMasks[row] |= bit;
-        columnMasks[column] |= bit;
-        boxMasks[box] |= bit;
+        BasicBoard copy(other);
+        *this = std::move(copy);
     }
-
-    return true;
+    return *this;
 }
 
-bool Board::findBestCell(const std::vector<unsigned int>& data,
-                         const std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                         const std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                         const std::array<uint16_t, BOARD_DIMENSION>& boxMasks,
-                         unsigned int& bestIndex,
-                         uint16_t& bestCandidateMask) const
+template <unsigned int Box, typename Rng>
+BasicBoard<Box, Rng>& BasicBoard<Box, Rng>::operator=(BasicBoard&& other) noexcept
 {
-    unsigned int bestCount = BOARD_DIMENSION + 1;
-    bestIndex = kBoardCells;
-    bestCandidateMask = 0;
-
-    for(unsigned int index = 0; index < kBoardCells; ++index)
-    {
-        if(data[index] != 0)
-            continue;
-
-        const unsigned int row = rowForIndex(index);
-        const unsigned int column = columnForIndex(index);
-        const unsigned int box = boxForRowColumn(row, column);
-        const uint16_t used = static_cast<uint16_t>(rowMasks[row] | columnMasks[column] | boxMasks[box]);
-        const uint16_t candidates = static_cast<uint16_t>(kAllDigitsMask & ~used);
-
-        if(candidates == 0)
-            return false;
-
-        const unsigned int count = std::popcount(candidates);
-        if(count < bestCount)
-        {
-            bestCount = count;
-            bestIndex = index;
-            bestCandidateMask = candidates;
-            if(bestCount == 1)
-                break;
-        }
-    }
-
-    return true;
+    std::swap(_boardData, other._boardData);
+    std::swap(_context, other._context);
+    std::swap(_lastGenerationStats, other._lastGenerationStats);
+    std::swap(_lastSearchStats, other._lastSearchStats);
+    std::swap(_searchStatsEnabled, other._searchStatsEnabled);
+    return *this;
 }
 
-bool Board::solveBoard(std::vector<unsigned int>& data,
-                       std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                       std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                       std::array<uint16_t, BOARD_DIMENSION>& boxMasks,
-                       bool randomize)
+template <unsigned int Box, typename Rng>
+BasicBoard<Box, Rng>::~BasicBoard()
 {
-    unsigned int bestIndex = kBoardCells;
-    uint16_t candidateMask = 0;
-    if(!findBestCell(data, rowMasks, columnMasks, boxMasks, bestIndex, candidateMask))
-        return false;
-
-    if(bestIndex == kBoardCells)
-        return true;
-
-    std::array<unsigned int, BOARD_DIMENSION> candidates{};
-    unsigned int candidateCount = 0;
-    for(unsigned int value = 1; value <= BOARD_DIMENSION; ++value)
-    {
-        if((candidateMask & (1u << value)) != 0)
-            candidates[candidateCount++] = value;
-    }
-
-    if(randomize)
-        std::shuffle(candidates.begin(), candidates.begin() + candidateCount, _rng);
+    if(_context != nullptr)
+        BasicSolverContext<Box, Rng>::release(std::move(_context));
+}
 
-    const unsigned int row = rowForIndex(bestIndex);
-    const unsigned int column = columnForIndex(bestIndex);
-    const unsigned int box = boxForRowColumn(row, column);
+template <unsigned int Box, typename Rng>
+void BasicBoard<Box, Rng>::setSeed(uint32_t seed)
+{
+    _context->rng().seed(seed);
+}
 
-    for(unsigned int i = 0; i < candidateCount; ++i)
-    {
-        const unsigned int value = candidates[i];
-        const uint16_t bit = static_cast<uint16_t>(1u << value);
+template <unsigned int Box, typename Rng>
+void BasicBoard<Box, Rng>::setPropagationEnabled(bool enabled)
+{
+    _context->solver().setPropagationEnabled(enabled);
+}
 
-        data[bestIndex] = value;
-        rowMasks[row] |= bit;
-        columnMasks[column] |= bit;
-        boxMasks[box] |= bit;
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::isPropagationEnabled() const
+{
+    return _context->solver().isPropagationEnabled();
+}
 
-        if(solveBoard(data, rowMasks, columnMasks, boxMasks, randomize))
-            return true;
+template <unsigned int Box, typename Rng>
+uint64_t BasicBoard<Box, Rng>::getLastSearchNodes() const
+{
+    return _context->lastSearchNodes();
+}
 
-        boxMasks[box] &= static_cast<uint16_t>(~bit);
-        columnMasks[column] &= static_cast<uint16_t>(~bit);
-        rowMasks[row] &= static_cast<uint16_t>(~bit);
-        data[bestIndex] = 0;
-    }
+template <unsigned int Box, typename Rng>
+void BasicBoard<Box, Rng>::attachSearchStats(bool reset) const
+{
+    if(reset)
+        _lastSearchStats.reset();
 
-    return false;
+    _context->setSearchStats(_searchStatsEnabled ? &_lastSearchStats : nullptr);
 }
 
-bool Board::solveBoard(std::vector<unsigned int>& data, bool randomize)
+namespace {
+
+template <typename Engine, typename GridType, typename Rng>
+bool solveWith(Engine& engine, GridType& data, Rng* rng)
 {
-    std::array<uint16_t, BOARD_DIMENSION> rowMasks{};
-    std::array<uint16_t, BOARD_DIMENSION> columnMasks{};
-    std::array<uint16_t, BOARD_DIMENSION> boxMasks{};
-    if(!initializeMasks(data, rowMasks, columnMasks, boxMasks))
+    if(!engine.load(data) || !engine.solve(rng))
         return false;
 
-    return solveBoard(data, rowMasks, columnMasks, boxMasks, randomize);
+    engine.store(data);
+    return true;
 }
 
-bool Board::generateSolution()
+template <typename Engine, typename GridType>
+uint64_t countWith(Engine& engine, const GridType& data, uint64_t limit)
 {
-    std::fill(_boardData.begin(), _boardData.end(), 0);
-    return solveBoard(_boardData, true);
+    if(!engine.load(data))
+        return 0;
+
+    return engine.count(limit);
 }
 
-unsigned int Board::countSolutionsImpl(std::vector<unsigned int>& data,
-                                       std::array<uint16_t, BOARD_DIMENSION>& rowMasks,
-                                       std::array<uint16_t, BOARD_DIMENSION>& columnMasks,
-                                       std::array<uint16_t, BOARD_DIMENSION>& boxMasks,
-                                       unsigned int limit) const
+template <typename Engine, typename GridType, typename Visitor>
+uint64_t enumerateWith(Engine& engine, const GridType& data, const Visitor& visit)
 {
-    unsigned int bestIndex = kBoardCells;
-    uint16_t candidateMask = 0;
-    if(!findBestCell(data, rowMasks, columnMasks, boxMasks, bestIndex, candidateMask))
+    if(!engine.load(data))
         return 0;
 
-    if(bestIndex == kBoardCells)
-        return 1;
+    return engine.enumerate(visit);
+}
 
-    const unsigned int row = rowForIndex(bestIndex);
-    const unsigned int column = columnForIndex(bestIndex);
-    const unsigned int box = boxForRowColumn(row, column);
+} // namespace
 
-    unsigned int total = 0;
-    for(unsigned int value = 1; value <= BOARD_DIMENSION; ++value)
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::solveBoard(GridType& data, bool randomize, SolverBackend backend)
+{
+    _context->setLastBackend(backend);
+    attachSearchStats(true);
+    Rng* rng = randomize ? &_context->rng() : nullptr;
+    if(backend == SolverBackend::Dlx)
+        return solveWith(_context->dlxSolver(), data, rng);
+    if constexpr(Box == 3)
     {
-        const uint16_t bit = static_cast<uint16_t>(1u << value);
-        if((candidateMask & bit) == 0)
-            continue;
-
-        data[bestIndex] = value;
-        rowMasks[row] |= bit;
-        columnMasks[column] |= bit;
-        boxMasks[box] |= bit;
-
-        total += countSolutionsImpl(data, rowMasks, columnMasks, boxMasks, limit - total);
-
-        boxMasks[box] &= static_cast<uint16_t>(~bit);
-        columnMasks[column] &= static_cast<uint16_t>(~bit);
-        rowMasks[row] &= static_cast<uint16_t>(~bit);
-        data[bestIndex] = 0;
-
-        if(total >= limit)
-            return total;
+        if(backend == SolverBackend::Bitboard)
+            return solveWith(_context->bitboardSolver(), data, rng);
     }
-
-    return total;
+    return solveWith(_context->solver(), data, rng);
 }
 
-unsigned int Board::countSolutionsOnData(std::vector<unsigned int>& data, unsigned int limit) const
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::generateSolution(SolverBackend backend)
 {
-    if(limit == 0)
-        return 0;
-
-    std::array<uint16_t, BOARD_DIMENSION> rowMasks{};
-    std::array<uint16_t, BOARD_DIMENSION> columnMasks{};
-    std::array<uint16_t, BOARD_DIMENSION> boxMasks{};
-    if(!initializeMasks(data, rowMasks, columnMasks, boxMasks))
-        return 0;
+    _boardData.fill(0);
+    return solveBoard(_boardData, true, backend);
+}
 
-    return countSolutionsImpl(data, rowMasks, columnMasks, boxMasks, limit);
+template <unsigned int Box, typename Rng>
+uint64_t BasicBoard<Box, Rng>::countSolutionsOnData(const GridType& data, uint64_t limit, SolverBackend backend) const
+{
+    _context->setLastBackend(backend);
+    attachSearchStats(true);
+    if(backend == SolverBackend::Dlx)
+        return countWith(_context->dlxSolver(), data, limit);
+    if constexpr(Box == 3)
+    {
+        if(backend == SolverBackend::Bitboard)
+            return countWith(_context->bitboardSolver(), data, limit);
+    }
+    return countWith(_context->solver(), data, limit);
 }
 
-bool Board::generatePuzzle(unsigned int clues)
+template <unsigned int Box, typename Rng>
+unsigned int BasicBoard<Box, Rng>::removeClues(unsigned int clues, SolverBackend backend, Difficulty ceiling, bool repair)
 {
-    if(clues > BOARD_DIMENSION * BOARD_DIMENSION)
-        return false;
+    constexpr unsigned int kBoardCells = Geometry<Box>::kCells;
 
-    if(!generateSolution())
-        return false;
+    _lastGenerationStats = GenerationStats{};
+    const GridType solution = _boardData;
+    Rng& rng = _context->rng();
+    BasicSolver<Box>& solver = _context->solver();
 
     std::array<unsigned int, kBoardCells> indices{};
     std::iota(indices.begin(), indices.end(), 0);
-    std::shuffle(indices.begin(), indices.end(), _rng);
+    shuffleRange(indices.begin(), indices.end(), rng);
+
+    // The puzzle stays unique after every accepted removal, so clearing a cell
+    // keeps it unique exactly when no solution puts another digit there. That
+    // single targeted search replaces a full two-solution count per removal.
+    // The MRV solver edits its loaded puzzle in place between removals; the
+    // other engines reload the puzzle for each check. Below Extreme, a puzzle
+    // the grader finishes within the ceiling is unique by construction, so the
+    // grade replaces the search and rejects removals that make it too hard.
+    _context->setLastBackend(backend);
+    attachSearchStats(false);
+    const bool logical = ceiling != Difficulty::Extreme;
+    const bool incremental = !logical
+        && (backend == SolverBackend::Mrv || (backend == SolverBackend::Bitboard && Box != 3));
+    if(incremental)
+        solver.load(_boardData);
+
+    auto isRemovable = [&](unsigned int index, unsigned int value) {
+        ++_lastGenerationStats.uniquenessChecks;
+        if(logical)
+            return _context->grader().grade(_boardData, ceiling) <= ceiling;
+
+        if(incremental)
+        {
+            solver.removeGiven(index);
+            if(solver.hasSolutionExcluding(index, value))
+            {
+                solver.restoreGiven(index, value);
+                return false;
+            }
+            return true;
+        }
+
+        if constexpr(Box == 3)
+        {
+            if(backend == SolverBackend::Bitboard)
+                return _context->bitboardSolver().load(_boardData) && !_context->bitboardSolver().hasSolutionExcluding(index, value);
+        }
+        return _context->dlxSolver().load(_boardData) && !_context->dlxSolver().hasSolutionExcluding(index, value);
+    };
+
+    auto tryRemove = [&](unsigned int index) {
+        const uint8_t previous = _boardData[index];
+        _boardData[index] = 0;
+        if(isRemovable(index, previous))
+            return true;
+        _boardData[index] = previous;
+        return false;
+    };
 
     unsigned int remaining = kBoardCells;
     for(unsigned int index : indices)
     {
         if(remaining <= clues)
             break;
+        if(tryRemove(index))
+            --remaining;
+    }
 
-        const unsigned int previous = _boardData[index];
-        _boardData[index] = 0;
+    // A stalled pass leaves a puzzle where no single clue can go. Rather than
+    // start over from a new solution, put one cleared clue back and look for
+    // two others to take out: two is a step towards the target, one swaps a
+    // clue for a neighbouring puzzle of the same size to continue from, and
+    // none restores the puzzle as it was.
+    const unsigned int repairSteps = !repair || logical ? 0 : kRepairStepsPerClue * (remaining - std::min(remaining, clues));
+    for(unsigned int step = 0; step < repairSteps && remaining > clues; ++step)
+    {
+        ++_lastGenerationStats.repairSteps;
 
-        if(countSolutionsOnData(_boardData, 2) == 1)
+        unsigned int emptyCount = 0;
+        unsigned int givenCount = 0;
+        for(unsigned int index = 0; index < kBoardCells; ++index)
         {
-            --remaining;
+            if(_boardData[index] == 0)
+                indices[emptyCount++] = index;
+        }
+        const unsigned int added = indices[uniformBelow(rng, emptyCount)];
+        _boardData[added] = solution[added];
+        if(incremental)
+            solver.restoreGiven(added, solution[added]);
+
+        for(unsigned int index = 0; index < kBoardCells; ++index)
+        {
+            if(_boardData[index] != 0 && index != added)
+                indices[givenCount++] = index;
+        }
+        shuffleRange(indices.begin(), indices.begin() + givenCount, rng);
+
+        unsigned int removed = 0;
+        for(unsigned int i = 0; i < givenCount && removed < 2; ++i)
+        {
+            if(tryRemove(indices[i]))
+                ++removed;
+        }
+
+        if(removed == 0)
+        {
+            // The puzzle without the added clue is the unique one we started from.
+            _boardData[added] = 0;
+            if(incremental)
+                solver.removeGiven(added);
         }
         else
         {
-            _boardData[index] = previous;
+            remaining = remaining + 1 - removed;
         }
     }
 
-    return remaining == clues;
+    return remaining;
+}
+
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::generatePuzzle(unsigned int clues, SolverBackend backend)
+{
+    if(clues > BOARD_DIMENSION * BOARD_DIMENSION)
+        return false;
+
+    if(!generateSolution(backend))
+        return false;
+
+    return removeClues(clues, backend, Difficulty::Extreme, true) == clues;
+}
+
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::generatePuzzle(Difficulty target, SolverBackend backend)
+{
+    if(!generateSolution(backend))
+        return false;
+
+    // Removals only ever make a puzzle harder, so clues are removed while it
+    // stays within the target tier; each trial grade stops at the first
+    // technique above the tier. The grid is abandoned if even the sparsest
+    // puzzle left is easier than the target.
+    removeClues(0, backend, target, false);
+    return _context->grader().grade(_boardData, target) == target;
+}
+
+template <unsigned int Box, typename Rng>
+Difficulty BasicBoard<Box, Rng>::grade() const
+{
+    return _context->grader().grade(_boardData);
 }
 
-unsigned int Board::countSolutions(unsigned int limit) const
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::solve(SolverBackend backend)
 {
-    _workBuffer = _boardData;
-    return countSolutionsOnData(_workBuffer, limit);
+    return solveBoard(_boardData, false, backend);
 }
 
-unsigned int Board::getIndexForRowColumn(unsigned int row, unsigned int column) const
+template <unsigned int Box, typename Rng>
+uint64_t BasicBoard<Box, Rng>::countSolutions(uint64_t limit, SolverBackend backend) const
+{
+    return countSolutionsOnData(_boardData, limit, backend);
+}
+
+template <unsigned int Box, typename Rng>
+uint64_t BasicBoard<Box, Rng>::forEachSolution(const BasicSolutionVisitor<Box>& visit, SolverBackend backend) const
+{
+    _context->setLastBackend(backend);
+    attachSearchStats(true);
+    if(backend == SolverBackend::Dlx)
+        return enumerateWith(_context->dlxSolver(), _boardData, visit);
+    if constexpr(Box == 3)
+    {
+        if(backend == SolverBackend::Bitboard)
+            return enumerateWith(_context->bitboardSolver(), _boardData, visit);
+    }
+    return enumerateWith(_context->solver(), _boardData, visit);
+}
+
+template <unsigned int Box, typename Rng>
+unsigned int BasicBoard<Box, Rng>::getIndexForRowColumn(unsigned int row, unsigned int column) const
 {
     return row * BOARD_DIMENSION + column;
 }
 
-std::vector<unsigned int> Board::getRow(unsigned int index) const
+template <unsigned int Box, typename Rng>
+typename BasicBoard<Box, Rng>::UnitViewType BasicBoard<Box, Rng>::getRow(unsigned int index) const
 {
     if(index >= BOARD_DIMENSION)
         throw std::out_of_range("Row index out of range");
 
-    std::vector<unsigned int> row(BOARD_DIMENSION);
-    const unsigned int start = index * BOARD_DIMENSION;
-    std::copy_n(_boardData.begin() + start, BOARD_DIMENSION, row.begin());
-    return row;
+    return UnitViewType::row(_boardData, index);
 }
 
-std::vector<unsigned int> Board::getColumn(unsigned int index) const
+template <unsigned int Box, typename Rng>
+typename BasicBoard<Box, Rng>::UnitViewType BasicBoard<Box, Rng>::getColumn(unsigned int index) const
 {
     if(index >= BOARD_DIMENSION)
         throw std::out_of_range("Column index out of range");
 
-    std::vector<unsigned int> column(BOARD_DIMENSION);
-    for(unsigned int y = 0; y < BOARD_DIMENSION; ++y)
-        column[y] = _boardData[y * BOARD_DIMENSION + index];
-
-    return column;
+    return UnitViewType::column(_boardData, index);
 }
 
-std::vector<unsigned int> Board::getQuadrant(unsigned int index) const
+template <unsigned int Box, typename Rng>
+typename BasicBoard<Box, Rng>::UnitViewType BasicBoard<Box, Rng>::getQuadrant(unsigned int index) const
 {
     if(index >= BOARD_DIMENSION)
         throw std::out_of_range("Quadrant index out of range");
 
-    std::vector<unsigned int> quadrant;
-    quadrant.reserve(BOARD_DIMENSION);
-
-    const unsigned int boxRow = (index / kBoxDimension) * kBoxDimension;
-    const unsigned int boxCol = (index % kBoxDimension) * kBoxDimension;
-
-    for(unsigned int y = 0; y < kBoxDimension; ++y)
-        for(unsigned int x = 0; x < kBoxDimension; ++x)
-            quadrant.push_back(_boardData[(boxRow + y) * BOARD_DIMENSION + (boxCol + x)]);
-
-    return quadrant;
+    return UnitViewType::box(_boardData, index);
 }
 
-unsigned int Board::getRowForIndex(unsigned int index) const
+template <unsigned int Box, typename Rng>
+unsigned int BasicBoard<Box, Rng>::getRowForIndex(unsigned int index) const
 {
-    if(index >= kBoardCells)
+    if(index >= Geometry<Box>::kCells)
         throw std::out_of_range("Cell index out of range");
 
-    return rowForIndex(index);
+    return rowForIndex<Box>(index);
 }
 
-unsigned int Board::getColumnForIndex(unsigned int index) const
+template <unsigned int Box, typename Rng>
+unsigned int BasicBoard<Box, Rng>::getColumnForIndex(unsigned int index) const
 {
-    if(index >= kBoardCells)
+    if(index >= Geometry<Box>::kCells)
         throw std::out_of_range("Cell index out of range");
 
-    return columnForIndex(index);
+    return columnForIndex<Box>(index);
 }
 
-unsigned int Board::getQuadrantForIndex(unsigned int index) const
+template <unsigned int Box, typename Rng>
+unsigned int BasicBoard<Box, Rng>::getQuadrantForIndex(unsigned int index) const
 {
-    if(index >= kBoardCells)
+    if(index >= Geometry<Box>::kCells)
         throw std::out_of_range("Cell index out of range");
 
-    const unsigned int row = rowForIndex(index);
-    const unsigned int column = columnForIndex(index);
+    const unsigned int row = rowForIndex<Box>(index);
+    const unsigned int column = columnForIndex<Box>(index);
 
-    return column / kBoxDimension + (row / kBoxDimension) * kBoxDimension;
+    return column / Box + (row / Box) * Box;
 }
 
-bool Board::isVectorUnique(const std::vector<unsigned int> & data) const
+namespace {
+
+template <unsigned int Box, typename Values>
+bool valuesAreUnique(const Values& values)
 {
-    uint16_t seen = 0;
-    for(unsigned int value : data)
+    using Mask = typename Geometry<Box>::Mask;
+
+    Mask seen = 0;
+    for(unsigned int value : values)
     {
         if(value == 0)
             continue;
 
-        if(value > BOARD_DIMENSION)
+        if(value > Geometry<Box>::kDimension)
             return false;
 
-        const uint16_t bit = static_cast<uint16_t>(1u << value);
+        const Mask bit = static_cast<Mask>(Mask{1} << value);
         if((seen & bit) != 0)
             return false;
         seen |= bit;
@@ -384,23 +464,99 @@ bool Board::isVectorUnique(const std::vector<unsigned int> & data) const
     return true;
 }
 
-std::ostream& sudoku::operator<<(std::ostream& os, const Board& board)
+} // namespace
+
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::isVectorUnique(const std::vector<unsigned int> & data) const
+{
+    return valuesAreUnique<Box>(data);
+}
+
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::isUnitUnique(const UnitViewType& unit) const
+{
+    return valuesAreUnique<Box>(unit);
+}
+
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::loadFromString(const std::string& text)
+{
+    constexpr unsigned int kBoardCells = Geometry<Box>::kCells;
+
+    if(text.size() != kBoardCells)
+        return false;
+
+    GridType parsed{};
+    for(unsigned int index = 0; index < kBoardCells; ++index)
+    {
+        const int value = digitFromChar(text[index]);
+        if(value < 0 || static_cast<unsigned int>(value) > BOARD_DIMENSION)
+            return false;
+        parsed[index] = static_cast<uint8_t>(value);
+    }
+
+    _boardData = parsed;
+    return true;
+}
+
+template <unsigned int Box, typename Rng>
+bool BasicBoard<Box, Rng>::loadFromData(const GridType& data)
+{
+    for(uint8_t value : data)
+    {
+        if(value > BOARD_DIMENSION)
+            return false;
+    }
+
+    _boardData = data;
+    return true;
+}
+
+template <unsigned int Box, typename Rng>
+std::string BasicBoard<Box, Rng>::toString() const
 {
-    os << "-------------------\n";
-    for(unsigned int y = 0; y < Board::BOARD_DIMENSION; ++y)
+    std::string text(Geometry<Box>::kCells, '.');
+    for(unsigned int index = 0; index < Geometry<Box>::kCells; ++index)
+        text[index] = digitToChar(_boardData[index]);
+    return text;
+}
+
+template <unsigned int Box, typename Rng>
+std::ostream& sudoku::operator<<(std::ostream& os, const BasicBoard<Box, Rng>& board)
+{
+    constexpr unsigned int kDimension = Geometry<Box>::kDimension;
+    constexpr unsigned int kCellWidth = kDimension < 10 ? 1 : 2;
+    const std::string separator(1 + kDimension * (kCellWidth + 1), '-');
+
+    os << separator << '\n';
+    for(unsigned int y = 0; y < kDimension; ++y)
     {
         os << '|';
-        for(unsigned int x = 0; x < Board::BOARD_DIMENSION; ++x)
+        for(unsigned int x = 0; x < kDimension; ++x)
         {
-            os << board._boardData[y * Board::BOARD_DIMENSION + x];
-            if(x % kBoxDimension == kBoxDimension - 1)
+            os << std::setw(kCellWidth) << static_cast<unsigned int>(board._boardData[y * kDimension + x]);
+            if(x % Box == Box - 1)
                 os << '|';
             else
                 os << ' ';
         }
         os << '\n';
-        if(y % kBoxDimension == kBoxDimension - 1)
-            os << "-------------------\n";
+        if(y % Box == Box - 1)
+            os << separator << '\n';
     }
     return os;
 }
+
+template class sudoku::BasicBoard<3>;
+template class sudoku::BasicBoard<4>;
+template class sudoku::BasicBoard<5>;
+template class sudoku::BasicBoard<3, Pcg32>;
+template class sudoku::BasicBoard<4, Pcg32>;
+template class sudoku::BasicBoard<5, Pcg32>;
+
+template std::ostream& sudoku::operator<<(std::ostream&, const BasicBoard<3>&);
+template std::ostream& sudoku::operator<<(std::ostream&, const BasicBoard<4>&);
+template std::ostream& sudoku::operator<<(std::ostream&, const BasicBoard<5>&);
+template std::ostream& sudoku::operator<<(std::ostream&, const BasicBoard<3, Pcg32>&);
+template std::ostream& sudoku::operator<<(std::ostream&, const BasicBoard<4, Pcg32>&);
+template std::ostream& sudoku::operator<<(std::ostream&, const BasicBoard<5, Pcg32>&);
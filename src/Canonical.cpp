@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "Canonical.h"
+#include "Random.h"
+
+using namespace sudoku;
+
+namespace {
+
+constexpr unsigned int kSize = 9;
+using Line = std::array<uint8_t, kSize>;
+
+constexpr uint8_t kPermutations[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+// A partial transform: an orientation, a full column order, the source rows
+// chosen for the first output rows and the digit labels handed out so far.
+struct Candidate
+{
+    uint8_t transpose = 0;
+    uint8_t nextLabel = 1;
+    uint16_t usedRows = 0;
+    Line columns{};
+    Line rows{};
+    // 0 for digits not seen yet.
+    std::array<uint8_t, 10> labels{};
+};
+
+// Relabels the next three cells of a first row: stack s of the source row,
+// in the given order, becomes output positions [3 * slot, 3 * slot + 3).
+std::array<uint8_t, 3> extendStack(Candidate& candidate, const uint8_t* source, unsigned int slot,
+                                   unsigned int stack, const uint8_t* order)
+{
+    std::array<uint8_t, 3> triple{};
+    for(unsigned int position = 0; position < 3; ++position)
+    {
+        const uint8_t column = static_cast<uint8_t>(3 * stack + order[position]);
+        candidate.columns[3 * slot + position] = column;
+        const uint8_t digit = source[column];
+        if(digit != 0 && candidate.labels[digit] == 0)
+            candidate.labels[digit] = candidate.nextLabel++;
+        triple[position] = candidate.labels[digit];
+    }
+    return triple;
+}
+
+// Appends source row `row` as the candidate's next output row and returns it
+// relabelled, giving unseen digits the next free labels.
+Line extend(Candidate& candidate, const Grid& frame, unsigned int row, unsigned int outputRow)
+{
+    candidate.rows[outputRow] = static_cast<uint8_t>(row);
+    candidate.usedRows = static_cast<uint16_t>(candidate.usedRows | (1u << row));
+
+    Line line{};
+    const uint8_t* source = frame.data() + row * kSize;
+    for(unsigned int position = 0; position < kSize; ++position)
+    {
+        const uint8_t digit = source[candidate.columns[position]];
+        if(digit != 0 && candidate.labels[digit] == 0)
+            candidate.labels[digit] = candidate.nextLabel++;
+        line[position] = candidate.labels[digit];
+    }
+    return line;
+}
+
+// Keeps the candidates whose line is smallest so far.
+template <std::size_t Width>
+class Beam
+{
+public:
+    void offer(const Candidate& candidate, const uint8_t* line)
+    {
+        if(!_empty)
+        {
+            const int order = std::memcmp(line, _best.data(), Width);
+            if(order > 0)
+                return;
+            if(order < 0)
+                _candidates.clear();
+        }
+        _empty = false;
+        std::memcpy(_best.data(), line, Width);
+        _candidates.push_back(candidate);
+    }
+
+    // Takes over candidates already known to tie on their smallest line.
+    void adopt(std::vector<Candidate>& tied)
+    {
+        _candidates.swap(tied);
+        _empty = _candidates.empty();
+    }
+
+    void reset()
+    {
+        _candidates.clear();
+        _empty = true;
+    }
+
+    std::vector<Candidate>& candidates() { return _candidates; }
+
+private:
+    std::vector<Candidate> _candidates;
+    std::array<uint8_t, Width> _best{};
+    bool _empty = true;
+};
+
+Grid transposed(const Grid& grid)
+{
+    Grid result{};
+    for(unsigned int row = 0; row < kSize; ++row)
+    {
+        for(unsigned int column = 0; column < kSize; ++column)
+            result[column * kSize + row] = grid[row * kSize + column];
+    }
+    return result;
+}
+
+} // namespace
+
+Grid sudoku::transformGrid(const GridTransform& transform, const Grid& grid)
+{
+    Grid result{};
+    for(unsigned int row = 0; row < kSize; ++row)
+    {
+        for(unsigned int column = 0; column < kSize; ++column)
+        {
+            const unsigned int source = transform.transpose
+                ? transform.columns[column] * kSize + transform.rows[row]
+                : transform.rows[row] * kSize + transform.columns[column];
+            result[row * kSize + column] = transform.digits[grid[source]];
+        }
+    }
+    return result;
+}
+
+Grid sudoku::untransformGrid(const GridTransform& transform, const Grid& transformed)
+{
+    std::array<uint8_t, 10> inverse{};
+    for(unsigned int digit = 0; digit <= kSize; ++digit)
+        inverse[transform.digits[digit]] = static_cast<uint8_t>(digit);
+
+    Grid result{};
+    for(unsigned int row = 0; row < kSize; ++row)
+    {
+        for(unsigned int column = 0; column < kSize; ++column)
+        {
+            const unsigned int source = transform.transpose
+                ? transform.columns[column] * kSize + transform.rows[row]
+                : transform.rows[row] * kSize + transform.columns[column];
+            result[source] = inverse[transformed[row * kSize + column]];
+        }
+    }
+    return result;
+}
+
+CanonicalForm sudoku::canonicalize(const Grid& grid)
+{
+    const std::array<Grid, 2> frames = {grid, transposed(grid)};
+    Beam<kSize> current;
+    Beam<kSize> next;
+
+    // Row 0 may be any source row in either orientation under any of the 1296
+    // column orders. The order is fixed one stack at a time: each step keeps
+    // only the choices whose three cells are smallest, across all 18 starting
+    // rows at once, so most of the orders are never built.
+    Beam<3> stacks;
+    Beam<3> stacksNext;
+    for(uint8_t transpose = 0; transpose < 2; ++transpose)
+    {
+        for(unsigned int row = 0; row < kSize; ++row)
+        {
+            Candidate candidate;
+            candidate.transpose = transpose;
+            candidate.rows[0] = static_cast<uint8_t>(row);
+            candidate.usedRows = static_cast<uint16_t>(1u << row);
+            for(unsigned int stack = 0; stack < 3; ++stack)
+            {
+                for(const auto& order : kPermutations)
+                {
+                    Candidate extended = candidate;
+                    const std::array<uint8_t, 3> triple = extendStack(extended, frames[transpose].data() + row * kSize, 0, stack, order);
+                    stacks.offer(extended, triple.data());
+                }
+            }
+        }
+    }
+    for(unsigned int slot = 1; slot < 3; ++slot)
+    {
+        stacksNext.reset();
+        for(const Candidate& candidate : stacks.candidates())
+        {
+            const uint8_t* source = frames[candidate.transpose].data() + candidate.rows[0] * kSize;
+            unsigned int usedStacks = 0;
+            for(unsigned int taken = 0; taken < slot; ++taken)
+                usedStacks |= 1u << (candidate.columns[3 * taken] / 3);
+            for(unsigned int stack = 0; stack < 3; ++stack)
+            {
+                if((usedStacks & (1u << stack)) != 0)
+                    continue;
+                for(const auto& order : kPermutations)
+                {
+                    Candidate extended = candidate;
+                    const std::array<uint8_t, 3> triple = extendStack(extended, source, slot, stack, order);
+                    stacksNext.offer(extended, triple.data());
+                }
+            }
+        }
+        std::swap(stacks, stacksNext);
+    }
+    current.adopt(stacks.candidates());
+
+    // Rows 1-8: a band's first row may come from any unused band, the other
+    // two from the band just started. Column orders are already fixed, so
+    // each candidate has at most six choices and most fall behind at once.
+    for(unsigned int outputRow = 1; outputRow < kSize; ++outputRow)
+    {
+        next.reset();
+        for(const Candidate& candidate : current.candidates())
+        {
+            const Grid& frame = frames[candidate.transpose];
+            const unsigned int band = candidate.rows[outputRow - 1] / 3;
+            for(unsigned int row = 0; row < kSize; ++row)
+            {
+                if((candidate.usedRows & (1u << row)) != 0)
+                    continue;
+                const bool startsBand = outputRow % 3 == 0;
+                if(startsBand ? ((candidate.usedRows >> (3 * (row / 3))) & 7u) != 0 : row / 3 != band)
+                    continue;
+
+                Candidate extended = candidate;
+                const Line line = extend(extended, frame, row, outputRow);
+                next.offer(extended, line.data());
+            }
+        }
+        std::swap(current, next);
+    }
+
+    // Every survivor yields the same grid; take the first. Digits missing
+    // from the puzzle get the remaining labels so the map stays a bijection
+    // and solutions can be mapped back.
+    const Candidate& chosen = current.candidates().front();
+    CanonicalForm form;
+    form.transform.transpose = chosen.transpose != 0;
+    form.transform.rows = chosen.rows;
+    form.transform.columns = chosen.columns;
+    uint8_t nextLabel = chosen.nextLabel;
+    for(unsigned int digit = 1; digit <= kSize; ++digit)
+        form.transform.digits[digit] = chosen.labels[digit] != 0 ? chosen.labels[digit] : nextLabel++;
+    form.grid = transformGrid(form.transform, grid);
+    return form;
+}
+
+CanonicalKey sudoku::canonicalKey(const Grid& canonical)
+{
+    CanonicalKey key{};
+    packGrid<3>(canonical, key.data());
+    return key;
+}
+
+std::size_t CanonicalKeyHash::operator()(const CanonicalKey& key) const
+{
+    uint64_t hash = 0;
+    for(std::size_t offset = 0; offset < key.size(); offset += 8)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, key.data() + offset, std::min<std::size_t>(8, key.size() - offset));
+        hash = splitMix64(hash ^ word);
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+bool DedupIndex::insertCanonical(const Grid& canonical)
+{
+    const CanonicalKey key = canonicalKey(canonical);
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _keys.insert(key).second;
+}
+
+std::size_t DedupIndex::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _keys.size();
+}
+
+void DedupIndex::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _keys.clear();
+}
@@ -0,0 +1,388 @@
+#include <algorithm>
+#include <array>
+#include "DlxSolver.h"
+#include "GridTables.h"
+
+using namespace sudoku;
+
+template <unsigned int Box>
+void BasicDlxSolver<Box>::build()
+{
+    _left.resize(kNodes);
+    _right.resize(kNodes);
+    _up.resize(kNodes);
+    _down.resize(kNodes);
+    _column.resize(kNodes);
+    _size.assign(kColumns + 1, 0);
+    _selected.reserve(kCells);
+
+    for(unsigned int header = 0; header <= kColumns; ++header)
+    {
+        _left[header] = header == 0 ? kColumns : header - 1;
+        _right[header] = header == kColumns ? 0 : header + 1;
+        _up[header] = header;
+        _down[header] = header;
+        _column[header] = header;
+    }
+
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const auto& units = kGridTables<Box>.cellUnits[cell];
+        for(unsigned int digit = 0; digit < kDimension; ++digit)
+        {
+            const unsigned int option = cell * kDimension + digit;
+            const unsigned int first = kFirstOptionNode + 4 * option;
+            // The first node sits in the cell column, which load() relies on.
+            const std::array<unsigned int, 4> columns = {
+                1 + cell,
+                1 + kCells + units[0] * kDimension + digit,
+                1 + 2 * kCells + units[1] * kDimension + digit,
+                1 + 3 * kCells + units[2] * kDimension + digit,
+            };
+
+            for(unsigned int k = 0; k < 4; ++k)
+            {
+                const unsigned int node = first + k;
+                const unsigned int header = columns[k];
+                _left[node] = first + (k + 3) % 4;
+                _right[node] = first + (k + 1) % 4;
+                _column[node] = header;
+                _up[node] = _up[header];
+                _down[node] = header;
+                _down[_up[header]] = node;
+                _up[header] = node;
+                ++_size[header];
+            }
+        }
+    }
+}
+
+template <unsigned int Box>
+void BasicDlxSolver<Box>::cover(unsigned int column)
+{
+    _left[_right[column]] = _left[column];
+    _right[_left[column]] = _right[column];
+    for(unsigned int row = _down[column]; row != column; row = _down[row])
+    {
+        for(unsigned int node = _right[row]; node != row; node = _right[node])
+        {
+            _up[_down[node]] = _up[node];
+            _down[_up[node]] = _down[node];
+            --_size[_column[node]];
+        }
+    }
+}
+
+template <unsigned int Box>
+void BasicDlxSolver<Box>::uncover(unsigned int column)
+{
+    for(unsigned int row = _up[column]; row != column; row = _up[row])
+    {
+        for(unsigned int node = _left[row]; node != row; node = _left[node])
+        {
+            ++_size[_column[node]];
+            _up[_down[node]] = node;
+            _down[_up[node]] = node;
+        }
+    }
+    _left[_right[column]] = column;
+    _right[_left[column]] = column;
+}
+
+template <unsigned int Box>
+void BasicDlxSolver<Box>::coverRow(unsigned int node)
+{
+    for(unsigned int other = _right[node]; other != node; other = _right[other])
+        cover(_column[other]);
+}
+
+template <unsigned int Box>
+void BasicDlxSolver<Box>::uncoverRow(unsigned int node)
+{
+    for(unsigned int other = _left[node]; other != node; other = _left[other])
+        uncover(_column[other]);
+}
+
+template <unsigned int Box>
+void BasicDlxSolver<Box>::setValue(unsigned int node, bool filled)
+{
+    const unsigned int option = (node - kFirstOptionNode) / 4;
+    _values[option / kDimension] = filled ? static_cast<uint8_t>(option % kDimension + 1) : 0;
+}
+
+template <unsigned int Box>
+void BasicDlxSolver<Box>::release(std::size_t keep)
+{
+    while(_selected.size() > keep)
+    {
+        const unsigned int node = _selected.back();
+        _selected.pop_back();
+        uncoverRow(node);
+        uncover(_column[node]);
+        setValue(node, false);
+    }
+}
+
+template <unsigned int Box>
+unsigned int BasicDlxSolver<Box>::chooseColumn() const
+{
+    unsigned int best = kRoot;
+    unsigned int bestSize = kDimension + 1;
+    unsigned int scanned = 0;
+    for(unsigned int column = _right[kRoot]; column != kRoot; column = _right[column])
+    {
+        ++scanned;
+        if(_size[column] < bestSize)
+        {
+            best = column;
+            bestSize = _size[column];
+            if(bestSize <= 1)
+                break;
+        }
+    }
+    recordScan(_stats, scanned);
+    return best;
+}
+
+template <unsigned int Box>
+bool BasicDlxSolver<Box>::load(const GridType& cells)
+{
+    if(_left.empty())
+        build();
+
+    release(0);
+
+    _values = cells;
+    _nodes = 0;
+    _consistent = false;
+
+    // Conflicting givens would select an option that an earlier given already
+    // removed from the matrix, so they are rejected before anything is covered.
+    using Mask = typename Shape::Mask;
+    std::array<Mask, kDimension> rowMasks{};
+    std::array<Mask, kDimension> columnMasks{};
+    std::array<Mask, kDimension> boxMasks{};
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const unsigned int value = cells[cell];
+        if(value == 0)
+            continue;
+        if(value > kDimension)
+            return false;
+
+        const auto& units = kGridTables<Box>.cellUnits[cell];
+        const Mask bit = static_cast<Mask>(Mask{1} << value);
+        if(((rowMasks[units[0]] | columnMasks[units[1]] | boxMasks[units[2]]) & bit) != 0)
+            return false;
+        rowMasks[units[0]] |= bit;
+        columnMasks[units[1]] |= bit;
+        boxMasks[units[2]] |= bit;
+    }
+
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        if(cells[cell] == 0)
+            continue;
+
+        const unsigned int node = kFirstOptionNode + 4 * (cell * kDimension + cells[cell] - 1);
+        cover(_column[node]);
+        coverRow(node);
+        _selected.push_back(node);
+    }
+
+    _givenCount = _selected.size();
+    _consistent = true;
+    return true;
+}
+
+template <unsigned int Box>
+template <typename Rng>
+bool BasicDlxSolver<Box>::search(Rng* rng, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    const unsigned int column = chooseColumn();
+    if(column == kRoot)
+        return true;
+    if(_size[column] == 0)
+        return false;
+
+    cover(column);
+
+    std::array<uint32_t, kDimension> rows{};
+    unsigned int rowCount = 0;
+    for(unsigned int row = _down[column]; row != column; row = _down[row])
+        rows[rowCount++] = row;
+
+    recordBranch(_stats, rowCount);
+
+    // Bit i stands for rows[i]; with an engine the rows are drawn from the
+    // mask in random order instead of shuffling the array.
+    static_assert(kDimension < 32, "Row indices must fit a 32-bit mask");
+    for(uint32_t remaining = (1u << rowCount) - 1; remaining != 0;)
+    {
+        const unsigned int index = rng != nullptr ? randomSetBit(*rng, remaining)
+                                                  : static_cast<unsigned int>(std::countr_zero(remaining));
+        remaining &= ~(1u << index);
+        const unsigned int row = rows[index];
+        setValue(row, true);
+        coverRow(row);
+        _selected.push_back(row);
+        if(search(rng, depth + 1))
+            return true;
+        recordBacktrack(_stats);
+        _selected.pop_back();
+        uncoverRow(row);
+        setValue(row, false);
+    }
+
+    uncover(column);
+    return false;
+}
+
+template <unsigned int Box>
+template <typename Rng>
+bool BasicDlxSolver<Box>::solve(Rng* rng)
+{
+    return _consistent && search(rng, 0);
+}
+
+template <unsigned int Box>
+uint64_t BasicDlxSolver<Box>::countImpl(uint64_t limit, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    const unsigned int column = chooseColumn();
+    if(column == kRoot)
+        return 1;
+    if(_size[column] == 0)
+        return 0;
+
+    cover(column);
+
+    recordBranch(_stats, _size[column]);
+    uint64_t total = 0;
+    for(unsigned int row = _down[column]; row != column && total < limit; row = _down[row])
+    {
+        setValue(row, true);
+        coverRow(row);
+        const uint64_t found = countImpl(limit - total, depth + 1);
+        if(found == 0)
+            recordBacktrack(_stats);
+        total += found;
+        uncoverRow(row);
+        setValue(row, false);
+    }
+
+    uncover(column);
+    return total;
+}
+
+template <unsigned int Box>
+uint64_t BasicDlxSolver<Box>::count(uint64_t limit)
+{
+    if(limit == 0 || !_consistent)
+        return 0;
+
+    release(_givenCount);
+    return countImpl(limit, 0);
+}
+
+template <unsigned int Box>
+bool BasicDlxSolver<Box>::enumerateImpl(const BasicSolutionVisitor<Box>& visit, uint64_t& visited, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    const unsigned int column = chooseColumn();
+    if(column == kRoot)
+    {
+        ++visited;
+        return visit(_values);
+    }
+    if(_size[column] == 0)
+        return true;
+
+    cover(column);
+
+    recordBranch(_stats, _size[column]);
+    bool more = true;
+    for(unsigned int row = _down[column]; row != column && more; row = _down[row])
+    {
+        const uint64_t before = visited;
+        setValue(row, true);
+        coverRow(row);
+        more = enumerateImpl(visit, visited, depth + 1);
+        if(visited == before)
+            recordBacktrack(_stats);
+        uncoverRow(row);
+        setValue(row, false);
+    }
+
+    uncover(column);
+    return more;
+}
+
+template <unsigned int Box>
+uint64_t BasicDlxSolver<Box>::enumerate(const BasicSolutionVisitor<Box>& visit)
+{
+    if(!_consistent)
+        return 0;
+
+    release(_givenCount);
+    uint64_t visited = 0;
+    enumerateImpl(visit, visited, 0);
+    return visited;
+}
+
+template <unsigned int Box>
+bool BasicDlxSolver<Box>::hasSolutionExcluding(unsigned int cell, unsigned int value)
+{
+    if(!_consistent || value == 0 || value > kDimension)
+        return false;
+
+    release(_givenCount);
+    if(_values[cell] != 0)
+        return false;
+
+    // The option's first node sits in the cell column, which stays uncovered
+    // while the cell is empty, so it is still linked there exactly when no
+    // given has removed the option.
+    const unsigned int first = kFirstOptionNode + 4 * (cell * kDimension + value - 1);
+    const bool present = _down[_up[first]] == first;
+    if(present)
+    {
+        for(unsigned int node = first; node < first + 4; ++node)
+        {
+            _up[_down[node]] = _up[node];
+            _down[_up[node]] = _down[node];
+            --_size[_column[node]];
+        }
+    }
+
+    const bool found = countImpl(1, 0) > 0;
+
+    if(present)
+    {
+        for(unsigned int node = first + 4; node-- > first;)
+        {
+            ++_size[_column[node]];
+            _up[_down[node]] = node;
+            _down[_up[node]] = node;
+        }
+    }
+    return found;
+}
+
+template class sudoku::BasicDlxSolver<3>;
+template class sudoku::BasicDlxSolver<4>;
+template class sudoku::BasicDlxSolver<5>;
+
+template bool sudoku::BasicDlxSolver<3>::solve(Xoshiro256PlusPlus*);
+template bool sudoku::BasicDlxSolver<4>::solve(Xoshiro256PlusPlus*);
+template bool sudoku::BasicDlxSolver<5>::solve(Xoshiro256PlusPlus*);
+template bool sudoku::BasicDlxSolver<3>::solve(Pcg32*);
+template bool sudoku::BasicDlxSolver<4>::solve(Pcg32*);
+template bool sudoku::BasicDlxSolver<5>::solve(Pcg32*);
@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <bit>
+#include "Grader.h"
+#include "GridTables.h"
+
+using namespace sudoku;
+
+template <unsigned int Box>
+bool BasicGrader<Box>::load(const GridType& cells)
+{
+    _values = cells;
+    _emptyCount = 0;
+    _contradiction = false;
+
+    std::array<Mask, Shape::kUnits> unitMasks{};
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const unsigned int value = cells[cell];
+        if(value == 0)
+        {
+            ++_emptyCount;
+            continue;
+        }
+        if(value > kDimension)
+            return false;
+
+        const auto& units = kGridTables<Box>.cellUnits[cell];
+        const Mask bit = static_cast<Mask>(Mask{1} << value);
+        Mask& row = unitMasks[units[0]];
+        Mask& column = unitMasks[kDimension + units[1]];
+        Mask& box = unitMasks[2 * kDimension + units[2]];
+        if(((row | column | box) & bit) != 0)
+            return false;
+        row |= bit;
+        column |= bit;
+        box |= bit;
+    }
+
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const auto& units = kGridTables<Box>.cellUnits[cell];
+        _candidates[cell] = cells[cell] != 0 ? 0 : static_cast<Mask>(Shape::kAllDigits
+            & ~(unitMasks[units[0]] | unitMasks[kDimension + units[1]] | unitMasks[2 * kDimension + units[2]]));
+    }
+    return true;
+}
+
+template <unsigned int Box>
+void BasicGrader<Box>::place(unsigned int cell, unsigned int digit)
+{
+    const Mask bit = static_cast<Mask>(Mask{1} << digit);
+    _values[cell] = static_cast<uint8_t>(digit);
+    _candidates[cell] = 0;
+    --_emptyCount;
+    for(unsigned int peer : kGridTables<Box>.peers[cell])
+        _candidates[peer] &= static_cast<Mask>(~bit);
+}
+
+template <unsigned int Box>
+bool BasicGrader<Box>::eliminate(unsigned int cell, Mask mask)
+{
+    if((_candidates[cell] & mask) == 0)
+        return false;
+    _candidates[cell] &= static_cast<Mask>(~mask);
+    if(_candidates[cell] == 0)
+        _contradiction = true;
+    return true;
+}
+
+template <unsigned int Box>
+bool BasicGrader<Box>::applySingles()
+{
+    const auto& tables = kGridTables<Box>;
+    for(;;)
+    {
+        bool placed = false;
+
+        for(unsigned int cell = 0; cell < kCells; ++cell)
+        {
+            if(_values[cell] != 0)
+                continue;
+            const Mask candidates = _candidates[cell];
+            if(candidates == 0)
+                return false;
+            if((candidates & (candidates - 1)) == 0)
+            {
+                place(cell, static_cast<unsigned int>(std::countr_zero(candidates)));
+                record(Technique::NakedSingle);
+                placed = true;
+            }
+        }
+
+        for(const auto& unit : tables.units)
+        {
+            Mask once = 0;
+            Mask twice = 0;
+            Mask filled = 0;
+            for(unsigned int cell : unit)
+            {
+                if(_values[cell] != 0)
+                {
+                    filled |= static_cast<Mask>(Mask{1} << _values[cell]);
+                    continue;
+                }
+                twice |= static_cast<Mask>(once & _candidates[cell]);
+                once |= _candidates[cell];
+            }
+            if(static_cast<Mask>(once | filled) != Shape::kAllDigits)
+                return false;
+
+            // A cell holding two hidden singles loses the second one when the
+            // first is placed; the next pass then reports the missing digit.
+            for(Mask hidden = static_cast<Mask>(once & ~twice); hidden != 0; hidden &= static_cast<Mask>(hidden - 1))
+            {
+                const Mask bit = static_cast<Mask>(hidden & (~hidden + 1));
+                for(unsigned int cell : unit)
+                {
+                    if((_candidates[cell] & bit) != 0)
+                    {
+                        place(cell, static_cast<unsigned int>(std::countr_zero(bit)));
+                        record(Technique::HiddenSingle);
+                        placed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if(!placed)
+            return true;
+    }
+}
+
+template <unsigned int Box>
+bool BasicGrader<Box>::applyLockedCandidates()
+{
+    const auto& tables = kGridTables<Box>;
+
+    // Pointing: a digit confined to one row or column of a box leaves the rest
+    // of that line.
+    for(unsigned int box = 0; box < kDimension; ++box)
+    {
+        std::array<uint32_t, kDimension + 1> rows{};
+        std::array<uint32_t, kDimension + 1> columns{};
+        for(unsigned int cell : tables.units[2 * kDimension + box])
+        {
+            const auto& units = tables.cellUnits[cell];
+            for(Mask mask = _candidates[cell]; mask != 0; mask &= static_cast<Mask>(mask - 1))
+            {
+                const unsigned int digit = static_cast<unsigned int>(std::countr_zero(mask));
+                rows[digit] |= 1u << units[0];
+                columns[digit] |= 1u << units[1];
+            }
+        }
+
+        for(unsigned int digit = 1; digit <= kDimension; ++digit)
+        {
+            const Mask bit = static_cast<Mask>(Mask{1} << digit);
+            for(unsigned int kind = 0; kind < 2; ++kind)
+            {
+                const uint32_t lines = kind == 0 ? rows[digit] : columns[digit];
+                if(std::popcount(lines) != 1)
+                    continue;
+
+                bool progress = false;
+                for(unsigned int cell : tables.units[kind * kDimension + std::countr_zero(lines)])
+                {
+                    if(tables.cellUnits[cell][2] != box)
+                        progress |= eliminate(cell, bit);
+                }
+                if(progress)
+                {
+                    record(Technique::LockedCandidates);
+                    return true;
+                }
+            }
+        }
+    }
+
+    // Claiming: a digit confined to one box within a line leaves the rest of
+    // that box.
+    for(unsigned int line = 0; line < 2 * kDimension; ++line)
+    {
+        const unsigned int kind = line / kDimension;
+        std::array<uint32_t, kDimension + 1> boxes{};
+        for(unsigned int cell : tables.units[line])
+        {
+            for(Mask mask = _candidates[cell]; mask != 0; mask &= static_cast<Mask>(mask - 1))
+                boxes[std::countr_zero(mask)] |= 1u << tables.cellUnits[cell][2];
+        }
+
+        for(unsigned int digit = 1; digit <= kDimension; ++digit)
+        {
+            if(std::popcount(boxes[digit]) != 1)
+                continue;
+
+            const Mask bit = static_cast<Mask>(Mask{1} << digit);
+            const unsigned int index = line % kDimension;
+            bool progress = false;
+            for(unsigned int cell : tables.units[2 * kDimension + std::countr_zero(boxes[digit])])
+            {
+                if(tables.cellUnits[cell][kind] != index)
+                    progress |= eliminate(cell, bit);
+            }
+            if(progress)
+            {
+                record(Technique::LockedCandidates);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <unsigned int Box>
+bool BasicGrader<Box>::applyNakedPairs()
+{
+    for(const auto& unit : kGridTables<Box>.units)
+    {
+        for(unsigned int first = 0; first < kDimension; ++first)
+        {
+            const Mask pair = _candidates[unit[first]];
+            if(std::popcount(pair) != 2)
+                continue;
+
+            for(unsigned int second = first + 1; second < kDimension; ++second)
+            {
+                if(_candidates[unit[second]] != pair)
+                    continue;
+
+                bool progress = false;
+                for(unsigned int position = 0; position < kDimension; ++position)
+                {
+                    if(position != first && position != second)
+                        progress |= eliminate(unit[position], pair);
+                }
+                if(progress)
+                {
+                    record(Technique::NakedPair);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+template <unsigned int Box>
+bool BasicGrader<Box>::applyHiddenPairs()
+{
+    for(const auto& unit : kGridTables<Box>.units)
+    {
+        // Positions within the unit where each digit is still possible.
+        std::array<uint32_t, kDimension + 1> positions{};
+        for(unsigned int position = 0; position < kDimension; ++position)
+        {
+            for(Mask mask = _candidates[unit[position]]; mask != 0; mask &= static_cast<Mask>(mask - 1))
+                positions[std::countr_zero(mask)] |= 1u << position;
+        }
+
+        for(unsigned int first = 1; first <= kDimension; ++first)
+        {
+            if(std::popcount(positions[first]) != 2)
+                continue;
+
+            for(unsigned int second = first + 1; second <= kDimension; ++second)
+            {
+                if(positions[second] != positions[first])
+                    continue;
+
+                const Mask others = static_cast<Mask>(Shape::kAllDigits & ~((Mask{1} << first) | (Mask{1} << second)));
+                bool progress = false;
+                for(uint32_t cells = positions[first]; cells != 0; cells &= cells - 1)
+                    progress |= eliminate(unit[std::countr_zero(cells)], others);
+                if(progress)
+                {
+                    record(Technique::HiddenPair);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+template <unsigned int Box>
+bool BasicGrader<Box>::applyXWings()
+{
+    // lines[kind][digit][line]: positions of digit along each row (kind 0) or
+    // column (kind 1).
+    std::array<std::array<std::array<uint32_t, kDimension>, kDimension + 1>, 2> lines{};
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const unsigned int row = cell / kDimension;
+        const unsigned int column = cell % kDimension;
+        for(Mask mask = _candidates[cell]; mask != 0; mask &= static_cast<Mask>(mask - 1))
+        {
+            const unsigned int digit = static_cast<unsigned int>(std::countr_zero(mask));
+            lines[0][digit][row] |= 1u << column;
+            lines[1][digit][column] |= 1u << row;
+        }
+    }
+
+    for(unsigned int kind = 0; kind < 2; ++kind)
+    {
+        for(unsigned int digit = 1; digit <= kDimension; ++digit)
+        {
+            const auto& positions = lines[kind][digit];
+            const Mask bit = static_cast<Mask>(Mask{1} << digit);
+            for(unsigned int first = 0; first < kDimension; ++first)
+            {
+                if(std::popcount(positions[first]) != 2)
+                    continue;
+
+                for(unsigned int second = first + 1; second < kDimension; ++second)
+                {
+                    if(positions[second] != positions[first])
+                        continue;
+
+                    // The digit sits on the two crossing lines in both base
+                    // lines, so every other cell of those crossing lines loses it.
+                    bool progress = false;
+                    for(uint32_t cross = positions[first]; cross != 0; cross &= cross - 1)
+                    {
+                        const unsigned int crossing = static_cast<unsigned int>(std::countr_zero(cross));
+                        for(unsigned int line = 0; line < kDimension; ++line)
+                        {
+                            if(line == first || line == second)
+                                continue;
+                            const unsigned int cell = kind == 0
+                                ? line * kDimension + crossing
+                                : crossing * kDimension + line;
+                            progress |= eliminate(cell, bit);
+                        }
+                    }
+                    if(progress)
+                    {
+                        record(Technique::XWing);
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+template <unsigned int Box>
+Difficulty BasicGrader<Box>::grade(const GridType& cells, Difficulty ceiling)
+{
+    _uses.fill(0);
+    _solved = false;
+    if(!load(cells))
+        return Difficulty::Extreme;
+
+    Difficulty hardest = Difficulty::Easy;
+    for(;;)
+    {
+        if(!applySingles())
+            return Difficulty::Extreme;
+        if(_emptyCount == 0)
+        {
+            _solved = true;
+            return hardest;
+        }
+
+        Difficulty tier = Difficulty::Medium;
+        bool progress = false;
+        while(!progress)
+        {
+            if(tier > ceiling || tier == Difficulty::Extreme)
+                return tier;
+
+            switch(tier)
+            {
+                case Difficulty::Medium:
+                    progress = applyLockedCandidates();
+                    break;
+                case Difficulty::Hard:
+                    progress = applyNakedPairs() || applyHiddenPairs();
+                    break;
+                default:
+                    progress = applyXWings();
+                    break;
+            }
+            if(!progress)
+                tier = static_cast<Difficulty>(static_cast<unsigned int>(tier) + 1);
+        }
+
+        if(_contradiction)
+            return Difficulty::Extreme;
+        hardest = std::max(hardest, tier);
+    }
+}
+
+template class sudoku::BasicGrader<3>;
+template class sudoku::BasicGrader<4>;
+template class sudoku::BasicGrader<5>;
@@ -0,0 +1,229 @@
+#include <array>
+#include <cstring>
+#include "PackedCorpus.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace sudoku;
+
+namespace {
+
+constexpr char kPackedMagic[4] = {'S', 'D', 'K', 'P'};
+
+bool isSupportedDimension(unsigned int dimension)
+{
+    return dimension == 9 || dimension == 16 || dimension == 25;
+}
+
+std::array<uint8_t, kPackedHeaderBytes> makeHeader(unsigned int dimension, uint64_t count)
+{
+    std::array<uint8_t, kPackedHeaderBytes> header{};
+    std::memcpy(header.data(), kPackedMagic, sizeof(kPackedMagic));
+    header[4] = kPackedVersion;
+    header[5] = static_cast<uint8_t>(dimension);
+    header[6] = static_cast<uint8_t>(packedBitsPerCell(dimension));
+    for(unsigned int byte = 0; byte < 8; ++byte)
+        header[8 + byte] = static_cast<uint8_t>(count >> (8 * byte));
+    return header;
+}
+
+// Validates a header and returns its dimension and record count.
+bool parseHeader(const uint8_t* header, unsigned int& dimension, uint64_t& count)
+{
+    if(std::memcmp(header, kPackedMagic, sizeof(kPackedMagic)) != 0 || header[4] != kPackedVersion)
+        return false;
+
+    dimension = header[5];
+    if(!isSupportedDimension(dimension) || header[6] != packedBitsPerCell(dimension))
+        return false;
+
+    count = 0;
+    for(unsigned int byte = 0; byte < 8; ++byte)
+        count |= static_cast<uint64_t>(header[8 + byte]) << (8 * byte);
+    return true;
+}
+
+} // namespace
+
+PackedReader::~PackedReader()
+{
+    close();
+}
+
+bool PackedReader::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize{};
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(kPackedHeaderBytes))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if(view == nullptr)
+    {
+        if(mapping != nullptr)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    _file = file;
+    _mapping = mapping;
+    _data = static_cast<const uint8_t*>(view);
+    _length = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if(descriptor < 0)
+        return false;
+    struct stat status{};
+    if(::fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(kPackedHeaderBytes))
+    {
+        ::close(descriptor);
+        return false;
+    }
+    const std::size_t length = static_cast<std::size_t>(status.st_size);
+    void* view = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // The mapping keeps the file referenced after the descriptor is closed.
+    ::close(descriptor);
+    if(view == MAP_FAILED)
+        return false;
+    ::madvise(view, length, MADV_SEQUENTIAL);
+    _data = static_cast<const uint8_t*>(view);
+    _length = length;
+#endif
+
+    unsigned int dimension = 0;
+    uint64_t count = 0;
+    if(!parseHeader(_data, dimension, count))
+    {
+        close();
+        return false;
+    }
+
+    const std::size_t recordBytes = packedRecordBytes(dimension);
+    if(count > (_length - kPackedHeaderBytes) / recordBytes)
+    {
+        close();
+        return false;
+    }
+
+    _records = _data + kPackedHeaderBytes;
+    _recordBytes = recordBytes;
+    _dimension = dimension;
+    _count = count;
+    return true;
+}
+
+void PackedReader::close()
+{
+    if(_data != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+        CloseHandle(static_cast<HANDLE>(_mapping));
+        CloseHandle(static_cast<HANDLE>(_file));
+        _mapping = nullptr;
+        _file = nullptr;
+#else
+        ::munmap(const_cast<uint8_t*>(_data), _length);
+#endif
+    }
+
+    _data = nullptr;
+    _length = 0;
+    _records = nullptr;
+    _recordBytes = 0;
+    _dimension = 0;
+    _count = 0;
+}
+
+bool PackedReader::isPackedFile(const std::string& path)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if(file == nullptr)
+        return false;
+
+    std::array<uint8_t, kPackedHeaderBytes> header{};
+    const bool complete = std::fread(header.data(), 1, header.size(), file) == header.size();
+    std::fclose(file);
+
+    unsigned int dimension = 0;
+    uint64_t count = 0;
+    return complete && parseHeader(header.data(), dimension, count);
+}
+
+PackedWriter::~PackedWriter()
+{
+    close();
+}
+
+bool PackedWriter::open(const std::string& path, unsigned int dimension)
+{
+    close();
+    if(!isSupportedDimension(dimension))
+        return false;
+
+    _file = std::fopen(path.c_str(), "wb");
+    if(_file == nullptr)
+        return false;
+
+    _dimension = dimension;
+    _recordBytes = packedRecordBytes(dimension);
+    _buffer.resize(kBufferBytes - kBufferBytes % _recordBytes);
+    _used = 0;
+    _count = 0;
+    _failed = false;
+
+    // Placeholder until close() knows the record count.
+    return writeHeader();
+}
+
+bool PackedWriter::writeHeader()
+{
+    const std::array<uint8_t, kPackedHeaderBytes> header = makeHeader(_dimension, _count);
+    if(std::fwrite(header.data(), 1, header.size(), _file) != header.size())
+        _failed = true;
+    return !_failed;
+}
+
+bool PackedWriter::flush()
+{
+    if(_used != 0 && std::fwrite(_buffer.data(), 1, _used, _file) != _used)
+        _failed = true;
+    _used = 0;
+    return !_failed;
+}
+
+bool PackedWriter::close()
+{
+    if(_file == nullptr)
+        return false;
+
+    flush();
+    if(std::fseek(_file, 0, SEEK_SET) != 0)
+        _failed = true;
+    else
+        writeHeader();
+    if(std::fclose(_file) != 0)
+        _failed = true;
+
+    _file = nullptr;
+    return !_failed;
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <bit>
+#include "GridTables.h"
+#include "ParallelCounter.h"
+
+using namespace sudoku;
+
+namespace {
+
+// Levels split up front so that every worker has something to steal.
+constexpr unsigned int kEagerSplitDepth = 2;
+
+} // namespace
+
+template <unsigned int Box>
+BasicParallelCounter<Box>::BasicParallelCounter(unsigned int threadCount)
+    : _pool(threadCount)
+{
+    for(unsigned int worker = 0; worker < _pool.size(); ++worker)
+    {
+        _queues.push_back(std::make_unique<WorkQueue>());
+        _solvers.push_back(std::make_unique<BasicSolver<Box>>());
+    }
+    _workerStats.resize(_pool.size());
+}
+
+template <unsigned int Box>
+void BasicParallelCounter<Box>::setSearchStatsEnabled(bool enabled)
+{
+    for(unsigned int worker = 0; worker < _pool.size(); ++worker)
+        _solvers[worker]->setSearchStats(enabled ? &_workerStats[worker] : nullptr);
+}
+
+template <unsigned int Box>
+void BasicParallelCounter<Box>::push(unsigned int worker, Task&& task)
+{
+    _outstanding.fetch_add(1, std::memory_order_relaxed);
+    WorkQueue& queue = *_queues[worker];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // A worker marks itself idle before it checks _pushes, and the push
+    // bumps _pushes before it checks _idle, so one of them sees the other.
+    _pushes.fetch_add(1);
+    if(_idle.load() != 0)
+    {
+        { std::lock_guard<std::mutex> lock(_parkMutex); }
+        _parked.notify_one();
+    }
+}
+
+template <unsigned int Box>
+bool BasicParallelCounter<Box>::pop(unsigned int worker, Task& task)
+{
+    WorkQueue& queue = *_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if(queue.tasks.empty())
+        return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+template <unsigned int Box>
+bool BasicParallelCounter<Box>::steal(unsigned int worker, Task& task)
+{
+    const unsigned int workers = _pool.size();
+    for(unsigned int offset = 1; offset < workers; ++offset)
+    {
+        WorkQueue& queue = *_queues[(worker + offset) % workers];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(queue.tasks.empty())
+            continue;
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        _steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+template <unsigned int Box>
+bool BasicParallelCounter<Box>::split(unsigned int worker, const Task& task)
+{
+    // Split eagerly near the root, and further down only while someone is
+    // waiting for work; deep subtrees are cheaper to count in one go.
+    if(_pool.size() == 1 || task.depth >= Shape::kDimension * 2)
+        return false;
+    if(task.depth >= kEagerSplitDepth && _idle.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    using Mask = typename Shape::Mask;
+    std::array<Mask, Shape::kDimension> rowMasks{};
+    std::array<Mask, Shape::kDimension> columnMasks{};
+    std::array<Mask, Shape::kDimension> boxMasks{};
+    for(unsigned int cell = 0; cell < Shape::kCells; ++cell)
+    {
+        if(task.cells[cell] == 0)
+            continue;
+        const auto& units = kGridTables<Box>.cellUnits[cell];
+        const Mask bit = static_cast<Mask>(Mask{1} << task.cells[cell]);
+        rowMasks[units[0]] |= bit;
+        columnMasks[units[1]] |= bit;
+        boxMasks[units[2]] |= bit;
+    }
+
+    unsigned int bestCell = Shape::kCells;
+    Mask bestCandidates = 0;
+    unsigned int bestCount = Shape::kDimension + 1;
+    unsigned int emptyCount = 0;
+    for(unsigned int cell = 0; cell < Shape::kCells; ++cell)
+    {
+        if(task.cells[cell] != 0)
+            continue;
+        ++emptyCount;
+        const auto& units = kGridTables<Box>.cellUnits[cell];
+        const Mask candidates = static_cast<Mask>(
+            Shape::kAllDigits & ~(rowMasks[units[0]] | columnMasks[units[1]] | boxMasks[units[2]]));
+        const unsigned int count = static_cast<unsigned int>(std::popcount(candidates));
+        if(count < bestCount)
+        {
+            bestCell = cell;
+            bestCandidates = candidates;
+            bestCount = count;
+        }
+    }
+
+    // Nearly full grids are not worth a task each; a dead cell needs no search.
+    if(emptyCount < Shape::kCells / 4)
+        return false;
+    if(bestCount == 0)
+        return true;
+
+    for(Mask mask = bestCandidates; mask != 0; mask &= static_cast<Mask>(mask - 1))
+    {
+        Task child{task.cells, task.depth + 1};
+        child.cells[bestCell] = static_cast<uint8_t>(std::countr_zero(mask));
+        push(worker, std::move(child));
+    }
+    return true;
+}
+
+template <unsigned int Box>
+void BasicParallelCounter<Box>::process(unsigned int worker, Task& task)
+{
+    _tasks.fetch_add(1, std::memory_order_relaxed);
+    if(_found.load(std::memory_order_relaxed) >= _limit || split(worker, task))
+        return;
+
+    BasicSolver<Box>& solver = *_solvers[worker];
+    if(solver.load(task.cells))
+        solver.countShared(_found, _limit);
+    _nodes.fetch_add(solver.nodes(), std::memory_order_relaxed);
+}
+
+template <unsigned int Box>
+void BasicParallelCounter<Box>::runWorker(unsigned int worker)
+{
+    Task task;
+    bool idle = false;
+    while(_outstanding.load(std::memory_order_acquire) != 0)
+    {
+        const uint64_t pushes = _pushes.load();
+        if(pop(worker, task) || steal(worker, task))
+        {
+            if(idle)
+            {
+                _idle.fetch_sub(1);
+                idle = false;
+            }
+            process(worker, task);
+            if(_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                { std::lock_guard<std::mutex> lock(_parkMutex); }
+                _parked.notify_all();
+            }
+            continue;
+        }
+
+        if(!idle)
+        {
+            _idle.fetch_add(1);
+            idle = true;
+        }
+        std::unique_lock<std::mutex> lock(_parkMutex);
+        _parked.wait(lock, [&] { return _pushes.load() != pushes || _outstanding.load() == 0; });
+    }
+
+    if(idle)
+        _idle.fetch_sub(1);
+}
+
+template <unsigned int Box>
+uint64_t BasicParallelCounter<Box>::count(const GridType& cells, uint64_t limit)
+{
+    _found.store(0);
+    _nodes.store(0);
+    _tasks.store(0);
+    _steals.store(0);
+    _idle.store(0);
+    _limit = limit;
+    _searchStats.reset();
+    for(SearchStats& stats : _workerStats)
+        stats.reset();
+
+    if(limit == 0 || !_solvers[0]->load(cells))
+        return 0;
+
+    push(0, Task{cells, 0});
+    // One item per queue; the pool hands each to a worker thread.
+    _pool.run(_pool.size(), [this](unsigned int, std::size_t item) {
+        runWorker(static_cast<unsigned int>(item));
+    });
+
+    for(const SearchStats& stats : _workerStats)
+        _searchStats.merge(stats);
+    return std::min(_found.load(), limit);
+}
+
+template class sudoku::BasicParallelCounter<3>;
+template class sudoku::BasicParallelCounter<4>;
+template class sudoku::BasicParallelCounter<5>;
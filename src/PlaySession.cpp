@@ -0,0 +1,202 @@
+#include <bit>
+#include "Board.h"
+#include "GridTables.h"
+#include "PlaySession.h"
+
+using namespace sudoku;
+
+namespace {
+
+// Indices of the cell's row, column and box among the 3D units.
+template <unsigned int Box>
+std::array<unsigned int, 3> unitsOf(unsigned int cell)
+{
+    constexpr unsigned int D = Geometry<Box>::kDimension;
+    const std::array<uint8_t, 3>& units = kGridTables<Box>.cellUnits[cell];
+    return {units[0], D + units[1], 2 * D + units[2]};
+}
+
+} // namespace
+
+template <unsigned int Box>
+BasicPlaySession<Box>::BasicPlaySession() = default;
+
+template <unsigned int Box>
+bool BasicPlaySession<Box>::load(const GridType& puzzle)
+{
+    for(uint8_t value : puzzle)
+    {
+        if(value > kDimension)
+            return false;
+    }
+
+    *this = BasicPlaySession();
+    _givens = puzzle;
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        if(puzzle[cell] != 0)
+            set(cell, puzzle[cell]);
+    }
+    return true;
+}
+
+template <unsigned int Box>
+void BasicPlaySession<Box>::add(unsigned int cell, unsigned int digit)
+{
+    for(unsigned int unit : unitsOf<Box>(cell))
+    {
+        const unsigned int count = ++_counts[unit][digit];
+        if(count == 1)
+            _present[unit] |= static_cast<Mask>(Mask{1} << digit);
+        else if(count == 2)
+            ++_conflicts;
+    }
+    ++_filled;
+}
+
+template <unsigned int Box>
+void BasicPlaySession<Box>::remove(unsigned int cell, unsigned int digit)
+{
+    for(unsigned int unit : unitsOf<Box>(cell))
+    {
+        const unsigned int count = --_counts[unit][digit];
+        if(count == 0)
+            _present[unit] &= static_cast<Mask>(~(Mask{1} << digit));
+        else if(count == 1)
+            --_conflicts;
+    }
+    --_filled;
+}
+
+template <unsigned int Box>
+void BasicPlaySession<Box>::set(unsigned int cell, unsigned int digit)
+{
+    if(_cells[cell] != 0)
+        remove(cell, _cells[cell]);
+    if(digit != 0)
+        add(cell, digit);
+    _cells[cell] = static_cast<uint8_t>(digit);
+}
+
+template <unsigned int Box>
+bool BasicPlaySession<Box>::place(unsigned int cell, unsigned int digit)
+{
+    if(cell >= kCells || digit > kDimension || _givens[cell] != 0)
+        return false;
+    const unsigned int before = _cells[cell];
+    if(before == digit)
+        return true;
+
+    _history.resize(_position);
+    _history.push_back(Move{static_cast<uint16_t>(cell), static_cast<uint8_t>(before), static_cast<uint8_t>(digit)});
+    ++_position;
+    set(cell, digit);
+    return true;
+}
+
+template <unsigned int Box>
+bool BasicPlaySession<Box>::undo()
+{
+    if(!canUndo())
+        return false;
+    const Move& move = _history[--_position];
+    set(move.cell, move.before);
+    return true;
+}
+
+template <unsigned int Box>
+bool BasicPlaySession<Box>::redo()
+{
+    if(!canRedo())
+        return false;
+    const Move& move = _history[_position++];
+    set(move.cell, move.after);
+    return true;
+}
+
+template <unsigned int Box>
+typename BasicPlaySession<Box>::Mask BasicPlaySession<Box>::candidates(unsigned int cell) const
+{
+    if(_cells[cell] != 0)
+        return 0;
+    const std::array<unsigned int, 3> units = unitsOf<Box>(cell);
+    return static_cast<Mask>(Shape::kAllDigits & ~(_present[units[0]] | _present[units[1]] | _present[units[2]]));
+}
+
+template <unsigned int Box>
+bool BasicPlaySession<Box>::hasConflict(unsigned int cell) const
+{
+    const unsigned int digit = _cells[cell];
+    if(digit == 0)
+        return false;
+    for(unsigned int unit : unitsOf<Box>(cell))
+    {
+        if(_counts[unit][digit] > 1)
+            return true;
+    }
+    return false;
+}
+
+template <unsigned int Box>
+std::optional<Hint> BasicPlaySession<Box>::hiddenSingle() const
+{
+    for(const auto& unit : kGridTables<Box>.units)
+    {
+        // Digits that are candidates of one open cell of the unit only.
+        Mask once = 0;
+        Mask twice = 0;
+        for(unsigned int cell : unit)
+        {
+            const Mask mask = candidates(cell);
+            twice |= once & mask;
+            once |= mask;
+        }
+        const Mask hidden = static_cast<Mask>(once & ~twice);
+        if(hidden == 0)
+            continue;
+
+        const Mask bit = static_cast<Mask>(hidden & -hidden);
+        for(unsigned int cell : unit)
+        {
+            if((candidates(cell) & bit) != 0)
+                return Hint{cell, static_cast<unsigned int>(std::countr_zero(bit)), HintReason::HiddenSingle};
+        }
+    }
+    return std::nullopt;
+}
+
+template <unsigned int Box>
+std::optional<Hint> BasicPlaySession<Box>::hint() const
+{
+    if(_filled == kCells || _conflicts != 0)
+        return std::nullopt;
+
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const Mask mask = candidates(cell);
+        if(std::has_single_bit(mask))
+            return Hint{cell, static_cast<unsigned int>(std::countr_zero(mask)), HintReason::NakedSingle};
+    }
+    if(std::optional<Hint> hidden = hiddenSingle())
+        return hidden;
+
+    if(!_solutionSearched)
+    {
+        _solutionSearched = true;
+        BasicBoard<Box> board;
+        if(board.loadFromData(_givens) && board.solve())
+            _solution = board.getBoardData();
+    }
+    if(!_solution.has_value())
+        return std::nullopt;
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        if(_cells[cell] == 0)
+            return Hint{cell, (*_solution)[cell], HintReason::Solution};
+    }
+    return std::nullopt;
+}
+
+template class sudoku::BasicPlaySession<3>;
+template class sudoku::BasicPlaySession<4>;
+template class sudoku::BasicPlaySession<5>;
@@ -0,0 +1,49 @@
+#include <ostream>
+#include "SearchStats.h"
+
+using namespace sudoku;
+
+void SearchStats::merge(const SearchStats& other)
+{
+    nodes += other.nodes;
+    backtracks += other.backtracks;
+    propagations += other.propagations;
+    scannedCells += other.scannedCells;
+    maxDepth = std::max(maxDepth, other.maxDepth);
+    for(unsigned int ways = 0; ways <= kMaxBranching; ++ways)
+        branching[ways] += other.branching[ways];
+}
+
+uint64_t SearchStats::branchingNodes() const
+{
+    uint64_t total = 0;
+    for(uint64_t count : branching)
+        total += count;
+    return total;
+}
+
+double SearchStats::averageBranching() const
+{
+    uint64_t ways = 0;
+    for(unsigned int width = 0; width <= kMaxBranching; ++width)
+        ways += width * branching[width];
+    const uint64_t total = branchingNodes();
+    return total == 0 ? 0.0 : static_cast<double>(ways) / static_cast<double>(total);
+}
+
+std::ostream& sudoku::operator<<(std::ostream& os, const SearchStats& stats)
+{
+    os << "nodes=" << stats.nodes << " backtracks=" << stats.backtracks << " propagations=" << stats.propagations
+       << " maxDepth=" << stats.maxDepth << " scanned=" << stats.scannedCells << " branching=";
+    bool first = true;
+    for(unsigned int ways = 0; ways <= SearchStats::kMaxBranching; ++ways)
+    {
+        if(stats.branching[ways] == 0)
+            continue;
+        os << (first ? "" : ",") << ways << ':' << stats.branching[ways];
+        first = false;
+    }
+    if(first)
+        os << '-';
+    return os;
+}
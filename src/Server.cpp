@@ -0,0 +1,585 @@
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <sstream>
+#include "Grader.h"
+#include "ParseUtils.h"
+#include "Random.h"
+#include "Server.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace sudoku;
+
+namespace {
+
+constexpr unsigned int kMaxGenerateAttempts = 1000;
+constexpr unsigned int kDefaultClues = 30;
+// Requests a connection may have queued or running before reading pauses.
+constexpr uint64_t kMaxInFlight = 1024;
+
+std::vector<std::string> splitWords(const std::string& line)
+{
+    std::vector<std::string> words;
+    std::istringstream stream(line);
+    std::string word;
+    while(stream >> word)
+        words.push_back(std::move(word));
+    return words;
+}
+
+std::string error(const char* reason)
+{
+    return std::string("error ") + reason;
+}
+
+std::string ok(const std::string& payload)
+{
+    return "ok " + payload;
+}
+
+} // namespace
+
+// Hands answers to its writer in request order, holding back any that finish
+// early, and bounds how far the reader may run ahead of the writer. Writes
+// run outside the lock, one thread at a time: a worker that finds a write in
+// progress leaves its answer for that writer, so a client that stops reading
+// holds at most one worker instead of every worker with an answer for it.
+class RequestServer::Session
+{
+public:
+    explicit Session(const std::function<void(const std::string&)>& write)
+        : _write(write)
+    {
+    }
+
+    uint64_t begin()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _drained.wait(lock, [this] { return _submitted - _written < kMaxInFlight; });
+        return _submitted++;
+    }
+
+    void complete(uint64_t sequence, std::string answer)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _ready.emplace(sequence, std::move(answer));
+        if(_writing)
+            return;
+        _writing = true;
+        while(true)
+        {
+            std::string burst;
+            uint64_t answers = 0;
+            for(auto next = _ready.begin(); next != _ready.end() && next->first == _written + answers; next = _ready.erase(next))
+            {
+                burst.append(next->second);
+                burst.push_back('\n');
+                ++answers;
+            }
+            if(answers == 0)
+                break;
+
+            lock.unlock();
+            _write(burst);
+            lock.lock();
+            _written += answers;
+            _drained.notify_all();
+        }
+        _writing = false;
+    }
+
+    // Waits until every request begun so far has been answered.
+    void drain()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _drained.wait(lock, [this] { return _written == _submitted; });
+    }
+
+private:
+    const std::function<void(const std::string&)>& _write;
+    std::mutex _mutex;
+    std::condition_variable _drained;
+    std::map<uint64_t, std::string> _ready;
+    uint64_t _submitted = 0;
+    // Answers written; the next burst starts at this sequence.
+    uint64_t _written = 0;
+    bool _writing = false;
+};
+
+RequestServer::RequestServer(const Options& options)
+    : _options(options)
+    , _boards(options.threads == 0 ? 1 : options.threads)
+    , _solvers(_options.searchTimeout.count() > 0 ? _boards.size() : 0)
+{
+    if(_options.cacheSize != 0)
+        _cache = std::make_unique<SolveCache>(_options.cacheSize);
+
+    _threads.reserve(_boards.size());
+    for(unsigned int worker = 0; worker < _boards.size(); ++worker)
+        _threads.emplace_back(&RequestServer::workerLoop, this, worker);
+}
+
+RequestServer::~RequestServer()
+{
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+
+    for(std::thread& thread : _threads)
+        thread.join();
+}
+
+unsigned int RequestServer::size() const
+{
+    return static_cast<unsigned int>(_boards.size());
+}
+
+void RequestServer::workerLoop(unsigned int worker)
+{
+    while(true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+            if(_jobs.empty())
+                return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        job.session->complete(job.sequence, handle(job.request, worker));
+    }
+}
+
+void RequestServer::submit(Session& session, std::string request)
+{
+    const uint64_t sequence = session.begin();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(Job{&session, sequence, std::move(request)});
+    }
+    _wake.notify_one();
+}
+
+void RequestServer::serveLines(const std::function<bool(std::string&)>& readLine,
+                               const std::function<void(const std::string&)>& write)
+{
+    Session session(write);
+    std::string line;
+    while(readLine(line))
+    {
+        if(!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if(line.empty())
+            continue;
+        submit(session, std::move(line));
+        line.clear();
+    }
+    session.drain();
+}
+
+void RequestServer::serve(std::istream& input, std::ostream& output)
+{
+    // A tied input (std::cin) flushes its output before every read, which
+    // would race with the workers writing answers.
+    std::ostream* tied = input.tie(nullptr);
+    serveLines([&](std::string& line) { return static_cast<bool>(std::getline(input, line)); },
+               [&](const std::string& burst) {
+                   output.write(burst.data(), static_cast<std::streamsize>(burst.size()));
+                   output.flush();
+               });
+    input.tie(tied);
+}
+
+std::string RequestServer::handle(const std::string& request, unsigned int worker)
+{
+    const std::vector<std::string> words = splitWords(request);
+    if(words.empty())
+        return error("empty request");
+
+    Board& board = _boards[worker];
+    const std::string& verb = words[0];
+    if(verb == "generate")
+        return generate(words, board);
+    if(verb == "solve")
+        return solve(words, board, worker);
+    if(verb == "count")
+        return count(words, board, worker);
+    if(verb == "validate")
+        return validate(words, board, worker);
+    return error("unknown request");
+}
+
+std::string RequestServer::generate(const std::vector<std::string>& words, Board& board)
+{
+    unsigned int clues = kDefaultClues;
+    std::optional<Difficulty> difficulty;
+    std::optional<uint32_t> seed;
+    bool solutionOnly = false;
+    for(std::size_t index = 1; index < words.size(); ++index)
+    {
+        const std::string& word = words[index];
+        if(word == "solution")
+        {
+            solutionOnly = true;
+            continue;
+        }
+        if(index + 1 == words.size())
+            return error("missing value");
+
+        const std::string& value = words[++index];
+        unsigned int parsed = 0;
+        Difficulty tier = Difficulty::Easy;
+        if(word == "clues" && parseUnsigned(value, parsed) && parsed <= Board::BOARD_DIMENSION * Board::BOARD_DIMENSION)
+            clues = parsed;
+        else if(word == "difficulty" && parseDifficulty(value, tier))
+            difficulty = tier;
+        else if(word == "seed" && parseUnsigned(value, parsed))
+            seed = parsed;
+        else
+            return error("invalid generate option");
+    }
+
+    board.setSeed(seed.has_value() ? *seed : deriveSeed(_options.masterSeed, _generated.fetch_add(1, std::memory_order_relaxed)));
+    for(unsigned int attempt = 0; attempt < kMaxGenerateAttempts; ++attempt)
+    {
+        const bool generated = solutionOnly ? board.generateSolution(_options.backend)
+            : difficulty.has_value() ? board.generatePuzzle(*difficulty, _options.backend)
+            : board.generatePuzzle(clues, _options.backend);
+        if(generated)
+            return ok(board.toString());
+    }
+    return error("generation failed");
+}
+
+std::string RequestServer::solve(const std::vector<std::string>& words, Board& board, unsigned int worker)
+{
+    if(words.size() != 2 || !board.loadFromString(words[1]))
+        return error("invalid puzzle");
+
+    if(!_solvers.empty())
+    {
+        SolveResult result;
+        if(!settleWithin(board.getBoardData(), worker, result))
+            return error("timeout");
+        if(result.status == SolveStatus::Unsolvable || !board.loadFromData(result.solution))
+            return error("unsolvable");
+        return ok(board.toString());
+    }
+    if(_cache != nullptr)
+    {
+        const SolveResult result = _cache->solve(board.getBoardData(), board, _options.backend);
+        if(result.status == SolveStatus::Unsolvable || !board.loadFromData(result.solution))
+            return error("unsolvable");
+        return ok(board.toString());
+    }
+    if(!board.solve(_options.backend))
+        return error("unsolvable");
+    return ok(board.toString());
+}
+
+std::string RequestServer::count(const std::vector<std::string>& words, Board& board, unsigned int worker)
+{
+    uint64_t limit = 2;
+    if(words.size() == 4 && (words[2] != "limit" || !parseUnsigned(words[3], limit) || limit == 0))
+        return error("invalid limit");
+    if((words.size() != 2 && words.size() != 4) || !board.loadFromString(words[1]))
+        return error("invalid puzzle");
+
+    if(!_solvers.empty())
+    {
+        uint64_t found = 0;
+        Grid solution{};
+        if(!searchWithin(board.getBoardData(), limit, worker, found, solution))
+            return error("timeout");
+        return ok(std::to_string(found));
+    }
+    return ok(std::to_string(board.countSolutions(limit, _options.backend)));
+}
+
+std::string RequestServer::validate(const std::vector<std::string>& words, Board& board, unsigned int worker)
+{
+    if(words.size() != 2 || !board.loadFromString(words[1]))
+        return error("invalid puzzle");
+
+    SolveStatus status = SolveStatus::Unsolvable;
+    if(!_solvers.empty())
+    {
+        SolveResult result;
+        if(!settleWithin(board.getBoardData(), worker, result))
+            return error("timeout");
+        status = result.status;
+    }
+    else if(_cache != nullptr)
+    {
+        status = _cache->solve(board.getBoardData(), board, _options.backend).status;
+    }
+    else
+    {
+        const uint64_t solutions = board.countSolutions(2, _options.backend);
+        status = solutions == 0 ? SolveStatus::Unsolvable : solutions == 1 ? SolveStatus::Unique : SolveStatus::Multiple;
+    }
+
+    switch(status)
+    {
+        case SolveStatus::Unique: return ok("unique");
+        case SolveStatus::Multiple: return ok("multiple");
+        default: return ok("unsolvable");
+    }
+}
+
+bool RequestServer::searchWithin(const Grid& puzzle, uint64_t limit, unsigned int worker, uint64_t& found, Grid& solution)
+{
+    Solver& solver = _solvers[worker];
+    found = 0;
+    if(!solver.load(puzzle))
+        return true;
+
+    const SearchBudget budget = SearchBudget::within(_options.searchTimeout);
+    solver.beginSearch();
+    while(found < limit)
+    {
+        const SearchStatus status = solver.resume(budget);
+        if(status == SearchStatus::BudgetExhausted)
+            return false;
+        if(status != SearchStatus::Found)
+            break;
+        if(found++ == 0)
+            solver.store(solution);
+    }
+    return true;
+}
+
+bool RequestServer::settleWithin(const Grid& puzzle, unsigned int worker, SolveResult& result)
+{
+    auto settle = [&](const Grid& grid) {
+        uint64_t found = 0;
+        if(!searchWithin(grid, 2, worker, found, result.solution))
+            return false;
+        result.status = found == 0 ? SolveStatus::Unsolvable : found == 1 ? SolveStatus::Unique : SolveStatus::Multiple;
+        return true;
+    };
+    if(_cache == nullptr)
+        return settle(puzzle);
+
+    // As SolveCache::solve, except that a timed-out search stores nothing.
+    const CanonicalForm form = canonicalize(puzzle);
+    const CanonicalKey key = canonicalKey(form.grid);
+    if(!_cache->lookup(key, result))
+    {
+        if(!settle(form.grid))
+            return false;
+        _cache->insert(key, result);
+    }
+    if(result.status != SolveStatus::Unsolvable)
+        result.solution = untransformGrid(form.transform, result.solution);
+    return true;
+}
+
+#ifdef _WIN32
+
+bool RequestServer::serveUnixSocket(const std::string&)
+{
+    return false;
+}
+
+void RequestServer::stop()
+{
+}
+
+#else
+
+namespace {
+
+void sendAll(int socket, const std::string& data)
+{
+#ifdef MSG_NOSIGNAL
+    constexpr int kFlags = MSG_NOSIGNAL;
+#else
+    constexpr int kFlags = 0;
+#endif
+    std::size_t sent = 0;
+    while(sent < data.size())
+    {
+        const ssize_t written = ::send(socket, data.data() + sent, data.size() - sent, kFlags);
+        if(written < 0 && errno == EINTR)
+            continue;
+        // The client has gone; its remaining answers are dropped.
+        if(written <= 0)
+            return;
+        sent += static_cast<std::size_t>(written);
+    }
+}
+
+// Buffered line reader over a connected socket.
+class SocketLineReader
+{
+public:
+    explicit SocketLineReader(int socket)
+        : _socket(socket)
+    {
+    }
+
+    bool readLine(std::string& line)
+    {
+        while(true)
+        {
+            const std::size_t end = _buffer.find('\n', _start);
+            if(end != std::string::npos)
+            {
+                line.assign(_buffer, _start, end - _start);
+                _start = end + 1;
+                return true;
+            }
+            _buffer.erase(0, _start);
+            _start = 0;
+
+            char chunk[4096];
+            const ssize_t received = ::recv(_socket, chunk, sizeof(chunk), 0);
+            if(received < 0 && errno == EINTR)
+                continue;
+            if(received <= 0)
+            {
+                // A last request without a newline still counts.
+                if(_buffer.empty())
+                    return false;
+                line.swap(_buffer);
+                _buffer.clear();
+                return true;
+            }
+            _buffer.append(chunk, static_cast<std::size_t>(received));
+        }
+    }
+
+private:
+    int _socket;
+    std::string _buffer;
+    std::size_t _start = 0;
+};
+
+} // namespace
+
+bool RequestServer::serveUnixSocket(const std::string& path)
+{
+    sockaddr_un address{};
+    if(path.empty() || path.size() >= sizeof(address.sun_path))
+        return false;
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, path.size());
+
+    // Only a stale socket is replaced; any other file at path is left alone.
+    struct stat existing{};
+    if(::lstat(path.c_str(), &existing) == 0)
+    {
+        if(!S_ISSOCK(existing.st_mode) || ::unlink(path.c_str()) != 0)
+            return false;
+    }
+    else if(errno != ENOENT)
+    {
+        return false;
+    }
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0)
+        return false;
+    if(::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 64) != 0)
+    {
+        ::close(listener);
+        return false;
+    }
+
+    _listener.store(listener);
+    _listening.store(true);
+    // Connection threads by id; each queues its id in _finishedConnections
+    // as it ends, and the loop joins those before every accept.
+    std::map<uint64_t, std::thread> connections;
+    uint64_t nextConnection = 0;
+    const std::size_t maxConnections = std::max<std::size_t>(_options.maxConnections, 1);
+    while(true)
+    {
+        std::vector<uint64_t> finished;
+        {
+            // At the cap, further clients wait in the listen backlog.
+            std::unique_lock<std::mutex> lock(_mutex);
+            _connectionDone.wait(lock, [&] {
+                return !_listening.load() || connections.size() - _finishedConnections.size() < maxConnections;
+            });
+            finished.swap(_finishedConnections);
+        }
+        for(uint64_t id : finished)
+        {
+            connections[id].join();
+            connections.erase(id);
+        }
+        if(!_listening.load())
+            break;
+
+        const int client = ::accept(listener, nullptr, nullptr);
+        if(client < 0)
+        {
+            if(errno == EINTR || errno == ECONNABORTED)
+                continue;
+            break;
+        }
+#ifdef SO_NOSIGPIPE
+        const int enabled = 1;
+        ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _clients.push_back(client);
+        }
+        const uint64_t id = nextConnection++;
+        connections.emplace(id, std::thread([this, client, id] {
+            SocketLineReader reader(client);
+            serveLines([&](std::string& line) { return reader.readLine(line); },
+                       [&](const std::string& burst) { sendAll(client, burst); });
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _clients.erase(std::find(_clients.begin(), _clients.end(), client));
+                _finishedConnections.push_back(id);
+            }
+            ::close(client);
+            _connectionDone.notify_all();
+        }));
+    }
+
+    _listening.store(false);
+    stop();
+    for(auto& [id, connection] : connections)
+        connection.join();
+    _finishedConnections.clear();
+    _listener.store(-1);
+    ::close(listener);
+    ::unlink(path.c_str());
+    return true;
+}
+
+void RequestServer::stop()
+{
+    _listening.store(false);
+    const int listener = _listener.load();
+    if(listener >= 0)
+        ::shutdown(listener, SHUT_RDWR);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // Both directions, so a send blocked on a client that stopped reading
+        // fails instead of holding its worker.
+        for(int client : _clients)
+            ::shutdown(client, SHUT_RDWR);
+    }
+    _connectionDone.notify_all();
+}
+
+#endif
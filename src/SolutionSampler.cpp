@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "SolutionSampler.h"
+
+#if !defined(SUDOKU_NO_SIMD) && (defined(__SSSE3__) || defined(__AVX2__))
+#define SUDOKU_SAMPLER_SHUFFLE 1
+#include <tmmintrin.h>
+#endif
+
+using namespace sudoku;
+
+namespace {
+
+constexpr unsigned int kSize = 9;
+
+using Shuffle = std::array<uint8_t, 16>;
+
+// The six orders of three rows of a band or three columns of a stack.
+constexpr std::array<std::array<uint8_t, 3>, 6> kOrders = {{
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0},
+}};
+
+constexpr unsigned int kLineOrderCount = 6 * 6 * 6 * 6;
+// Ways to deal digits 1-9 into three sets of three, and to order each set.
+constexpr unsigned int kLabelSetCount = 1680;
+constexpr unsigned int kLabelOrderCount = 6 * 6 * 6;
+constexpr unsigned int kGeometryCount = 2 * kLineOrderCount * kLineOrderCount;
+constexpr unsigned int kLabelCount = kLabelSetCount * kLabelOrderCount; // 9!
+
+// Byte shuffles behind the transforms, padded to 16 bytes for a byte-shuffle
+// instruction; padding lanes of the line orders are 0x80, which reads as 0.
+struct ShuffleTables
+{
+    // Orders of nine rows (or columns) that keep bands (or stacks)
+    // together: order i takes its block order from base-6 digit 0 of i and
+    // the order within block b from digit b + 1.
+    std::array<Shuffle, kLineOrderCount> lineOrders{};
+    // Position p (1-9) to digit: positions 1-3 get the smallest to largest
+    // digit of the first set, and so on.
+    std::array<Shuffle, kLabelSetCount> labelSets{};
+    // Digit to position within its block of three; composing a set and an
+    // order gives each of the 9! relabellings exactly once.
+    std::array<Shuffle, kLabelOrderCount> labelOrders{};
+};
+
+constexpr ShuffleTables makeShuffleTables()
+{
+    ShuffleTables tables;
+    for(unsigned int index = 0; index < kLineOrderCount; ++index)
+    {
+        Shuffle& order = tables.lineOrders[index];
+        order.fill(0x80);
+        const std::array<uint8_t, 3>& blocks = kOrders[index % 6];
+        unsigned int rest = index / 6;
+        for(unsigned int block = 0; block < 3; ++block, rest /= 6)
+        {
+            for(unsigned int line = 0; line < 3; ++line)
+                order[block * 3 + line] = static_cast<uint8_t>(blocks[block] * 3 + kOrders[rest % 6][line]);
+        }
+    }
+
+    unsigned int count = 0;
+    for(unsigned int first = 0; first < 512; ++first)
+    {
+        for(unsigned int second = 0; second < 512; ++second)
+        {
+            if(std::popcount(first) != 3 || std::popcount(second) != 3 || (first & second) != 0)
+                continue;
+            const std::array<unsigned int, 3> sets = {first, second, 511u & ~(first | second)};
+            Shuffle& labels = tables.labelSets[count++];
+            unsigned int position = 1;
+            for(unsigned int set : sets)
+            {
+                for(unsigned int digit = 1; digit <= kSize; ++digit)
+                {
+                    if((set >> (digit - 1) & 1) != 0)
+                        labels[position++] = static_cast<uint8_t>(digit);
+                }
+            }
+        }
+    }
+
+    for(unsigned int index = 0; index < kLabelOrderCount; ++index)
+    {
+        Shuffle& order = tables.labelOrders[index];
+        unsigned int rest = index;
+        for(unsigned int block = 0; block < 3; ++block, rest /= 6)
+        {
+            for(unsigned int digit = 0; digit < 3; ++digit)
+                order[1 + block * 3 + digit] = static_cast<uint8_t>(1 + block * 3 + kOrders[rest % 6][digit]);
+        }
+    }
+    return tables;
+}
+
+constexpr ShuffleTables kTables = makeShuffleTables();
+
+// Table indices of the transform picked by a random word.
+struct Draw
+{
+    bool transpose;
+    uint32_t rows;
+    uint32_t columns;
+    uint32_t labelSet;
+    uint32_t labelOrder;
+};
+
+// Reads the word as a mixed-radix number. The divisors are constants, so
+// each step is a multiplication rather than a division.
+Draw drawFromWord(uint64_t word)
+{
+    const auto geometry = static_cast<uint32_t>(word % kGeometryCount);
+    const auto labels = static_cast<uint32_t>(word / kGeometryCount % kLabelCount);
+    return Draw{
+        (geometry & 1) != 0,
+        (geometry >> 1) % kLineOrderCount,
+        (geometry >> 1) / kLineOrderCount,
+        labels % kLabelSetCount,
+        labels / kLabelSetCount,
+    };
+}
+
+} // namespace
+
+GridTransform sudoku::transformFromWord(uint64_t word)
+{
+    const Draw draw = drawFromWord(word);
+    GridTransform transform;
+    transform.transpose = draw.transpose;
+    const Shuffle& rows = kTables.lineOrders[draw.rows];
+    const Shuffle& columns = kTables.lineOrders[draw.columns];
+    std::copy(rows.begin(), rows.begin() + kSize, transform.rows.begin());
+    std::copy(columns.begin(), columns.begin() + kSize, transform.columns.begin());
+    for(unsigned int digit = 1; digit <= kSize; ++digit)
+        transform.digits[digit] = kTables.labelSets[draw.labelSet][kTables.labelOrders[draw.labelOrder][digit]];
+    return transform;
+}
+
+SolutionSampler::SolutionSampler(uint32_t seed)
+    : SolutionSampler(seed, Options{})
+{
+}
+
+SolutionSampler::SolutionSampler(uint32_t seed, const Options& options)
+    : _options(options)
+    , _rng(seed)
+    , _board(deriveSeed(seed, 0))
+    , _pool(2 * std::max<std::size_t>(options.poolSize, 1))
+{
+    for(std::size_t slot = 0; slot < poolSize(); ++slot)
+        searchSeed(slot);
+}
+
+void SolutionSampler::searchSeed(std::size_t slot)
+{
+    // A search from the empty grid always finds a solution.
+    _board.generateSolution(_options.backend);
+    const Grid& grid = _board.getBoardData();
+    PaddedGrid& searched = _pool[2 * slot];
+    PaddedGrid& transposed = _pool[2 * slot + 1];
+    for(unsigned int row = 0; row < kSize; ++row)
+    {
+        for(unsigned int column = 0; column < kSize; ++column)
+        {
+            searched.rows[row][column] = grid[row * kSize + column];
+            transposed.rows[column][row] = grid[row * kSize + column];
+        }
+    }
+    ++_searchedSeeds;
+}
+
+void SolutionSampler::next(Grid& grid)
+{
+    if(_options.freshInterval != 0 && ++_sinceFresh == _options.freshInterval)
+    {
+        _sinceFresh = 0;
+        searchSeed(_oldestSeed);
+        _oldestSeed = (_oldestSeed + 1) % poolSize();
+    }
+
+    const Draw draw = drawFromWord(_rng());
+    const std::size_t seed = uniformBelow(_rng, static_cast<uint32_t>(poolSize()));
+    const PaddedGrid& source = _pool[2 * seed + (draw.transpose ? 1 : 0)];
+    const Shuffle& rows = kTables.lineOrders[draw.rows];
+    const Shuffle& columns = kTables.lineOrders[draw.columns];
+    const Shuffle& labelSet = kTables.labelSets[draw.labelSet];
+    const Shuffle& labelOrder = kTables.labelOrders[draw.labelOrder];
+
+#if defined(SUDOKU_SAMPLER_SHUFFLE)
+    // Each output row is one source row with its columns reordered and its
+    // digits relabelled by two byte shuffles. A 16-byte store spills into
+    // the next row, which is written afterwards; the last row goes through
+    // a buffer so nothing is written past the grid.
+    const __m128i order = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.data()));
+    const __m128i digits = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(labelSet.data())),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(labelOrder.data())));
+
+    alignas(16) Shuffle last;
+    for(unsigned int row = 0; row < kSize; ++row)
+    {
+        const __m128i line = _mm_load_si128(reinterpret_cast<const __m128i*>(source.rows[rows[row]].data()));
+        const __m128i result = _mm_shuffle_epi8(digits, _mm_shuffle_epi8(line, order));
+        if(row + 1 < kSize)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(grid.data() + row * kSize), result);
+        else
+            _mm_store_si128(reinterpret_cast<__m128i*>(last.data()), result);
+    }
+    std::memcpy(grid.data() + (kSize - 1) * kSize, last.data(), kSize);
+#else
+    std::array<uint8_t, 10> digits{};
+    for(unsigned int digit = 1; digit <= kSize; ++digit)
+        digits[digit] = labelSet[labelOrder[digit]];
+    for(unsigned int row = 0; row < kSize; ++row)
+    {
+        const Shuffle& line = source.rows[rows[row]];
+        for(unsigned int column = 0; column < kSize; ++column)
+            grid[row * kSize + column] = digits[line[columns[column]]];
+    }
+#endif
+}
+
+void SolutionSampler::fill(std::span<Grid> grids)
+{
+    for(Grid& grid : grids)
+        next(grid);
+}
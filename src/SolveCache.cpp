@@ -0,0 +1,105 @@
+#include "SolveCache.h"
+
+using namespace sudoku;
+
+SolveCache::SolveCache(std::size_t capacity)
+    : _capacity(capacity)
+{
+    _slots.reserve(capacity);
+    _index.reserve(capacity);
+}
+
+SolveResult SolveCache::solve(const Grid& puzzle, Board& board, SolverBackend backend)
+{
+    const CanonicalForm form = canonicalize(puzzle);
+    const CanonicalKey key = canonicalKey(form.grid);
+
+    SolveResult result;
+    if(!lookup(key, result))
+    {
+        // One search settles both answers: keep the first solution and stop
+        // at the second.
+        uint64_t found = 0;
+        if(board.loadFromData(form.grid))
+        {
+            found = board.forEachSolution([&](const Grid& solution) {
+                if(result.solution == Grid{})
+                    result.solution = solution;
+                return result.solution == solution;
+            }, backend);
+        }
+        result.status = found == 0 ? SolveStatus::Unsolvable
+            : found == 1 ? SolveStatus::Unique : SolveStatus::Multiple;
+        insert(key, result);
+    }
+
+    if(result.status != SolveStatus::Unsolvable)
+        result.solution = untransformGrid(form.transform, result.solution);
+    return result;
+}
+
+bool SolveCache::lookup(const CanonicalKey& key, SolveResult& result)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto found = _index.find(key);
+    if(found == _index.end())
+    {
+        ++_counters.misses;
+        return false;
+    }
+    ++_counters.hits;
+    Slot& slot = _slots[found->second];
+    slot.referenced = true;
+    result = slot.result;
+    return true;
+}
+
+void SolveCache::insert(const CanonicalKey& key, const SolveResult& result)
+{
+    if(_capacity == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Another thread may have solved the same puzzle meanwhile.
+    if(_index.count(key) != 0)
+        return;
+
+    if(_slots.size() < _capacity)
+    {
+        _index.emplace(key, _slots.size());
+        _slots.push_back(Slot{key, result, false});
+        return;
+    }
+
+    while(_slots[_hand].referenced)
+    {
+        _slots[_hand].referenced = false;
+        _hand = (_hand + 1) % _capacity;
+    }
+    Slot& victim = _slots[_hand];
+    _index.erase(victim.key);
+    ++_counters.evictions;
+    victim = Slot{key, result, false};
+    _index.emplace(key, _hand);
+    _hand = (_hand + 1) % _capacity;
+}
+
+SolveCacheCounters SolveCache::counters() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _counters;
+}
+
+std::size_t SolveCache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _slots.size();
+}
+
+void SolveCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _slots.clear();
+    _index.clear();
+    _hand = 0;
+}
@@ -0,0 +1,629 @@
+#include <algorithm>
+#include <bit>
+#include "GridTables.h"
+#include "Solver.h"
+
+using namespace sudoku;
+
+template <unsigned int Box>
+typename BasicSolver<Box>::Mask BasicSolver<Box>::candidatesFromUnits(unsigned int cell) const
+{
+    const auto& units = kGridTables<Box>.cellUnits[cell];
+    return static_cast<Mask>(Shape::kAllDigits & ~(_rowMasks[units[0]] | _columnMasks[units[1]] | _boxMasks[units[2]]));
+}
+
+template <unsigned int Box>
+bool BasicSolver<Box>::load(const GridType& cells)
+{
+    // Givens are never undone, so they are applied through unit masks in one
+    // pass instead of through assign() and the trail.
+    _rowMasks.fill(0);
+    _columnMasks.fill(0);
+    _boxMasks.fill(0);
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        const unsigned int value = cells[cell];
+        _values[cell] = cells[cell];
+        if(value == 0)
+            continue;
+        if(value > kDimension)
+            return false;
+
+        const auto& units = kGridTables<Box>.cellUnits[cell];
+        const Mask bit = static_cast<Mask>(Mask{1} << value);
+        if(((_rowMasks[units[0]] | _columnMasks[units[1]] | _boxMasks[units[2]]) & bit) != 0)
+            return false;
+        _rowMasks[units[0]] |= bit;
+        _columnMasks[units[1]] |= bit;
+        _boxMasks[units[2]] |= bit;
+    }
+
+    _phase = Phase::Idle;
+    _emptyCount = 0;
+    _trailSize = 0;
+    _assignmentCount = 0;
+    _pendingCount = 0;
+    _consistent = true;
+    _nodes = 0;
+
+    for(unsigned int cell = 0; cell < kCells; ++cell)
+    {
+        if(_values[cell] != 0)
+        {
+            _candidates[cell] = static_cast<Mask>(Mask{1} << _values[cell]);
+            continue;
+        }
+
+        const Mask candidates = candidatesFromUnits(cell);
+        _candidates[cell] = candidates;
+        _empty[_emptyCount] = static_cast<Cell>(cell);
+        _emptyPosition[cell] = static_cast<Cell>(_emptyCount++);
+
+        if(candidates == 0)
+            _consistent = false;
+        else if((candidates & (candidates - 1)) == 0)
+            _pending[_pendingCount++] = static_cast<Cell>(cell);
+    }
+
+    return true;
+}
+
+template <unsigned int Box>
+void BasicSolver<Box>::removeGiven(unsigned int cell)
+{
+    _phase = Phase::Idle;
+    undo(0);
+
+    const auto& units = kGridTables<Box>.cellUnits[cell];
+    const Mask bit = static_cast<Mask>(Mask{1} << _values[cell]);
+    _rowMasks[units[0]] &= static_cast<Mask>(~bit);
+    _columnMasks[units[1]] &= static_cast<Mask>(~bit);
+    _boxMasks[units[2]] &= static_cast<Mask>(~bit);
+
+    _values[cell] = 0;
+    _candidates[cell] = candidatesFromUnits(cell);
+    _empty[_emptyCount] = static_cast<Cell>(cell);
+    _emptyPosition[cell] = static_cast<Cell>(_emptyCount++);
+
+    for(Cell peer : kGridTables<Box>.peers[cell])
+    {
+        if(_values[peer] == 0)
+            _candidates[peer] = candidatesFromUnits(peer);
+    }
+}
+
+template <unsigned int Box>
+void BasicSolver<Box>::restoreGiven(unsigned int cell, unsigned int value)
+{
+    _phase = Phase::Idle;
+    undo(0);
+
+    const auto& units = kGridTables<Box>.cellUnits[cell];
+    const Mask bit = static_cast<Mask>(Mask{1} << value);
+    _rowMasks[units[0]] |= bit;
+    _columnMasks[units[1]] |= bit;
+    _boxMasks[units[2]] |= bit;
+
+    _values[cell] = static_cast<uint8_t>(value);
+    _candidates[cell] = bit;
+    const unsigned int position = _emptyPosition[cell];
+    const Cell last = _empty[--_emptyCount];
+    _empty[position] = last;
+    _emptyPosition[last] = static_cast<Cell>(position);
+
+    for(Cell peer : kGridTables<Box>.peers[cell])
+    {
+        if(_values[peer] == 0)
+            _candidates[peer] &= static_cast<Mask>(~bit);
+    }
+}
+
+template <unsigned int Box>
+void BasicSolver<Box>::queueNakedSingles()
+{
+    _pendingCount = 0;
+    for(unsigned int i = 0; i < _emptyCount; ++i)
+    {
+        const Mask candidates = _candidates[_empty[i]];
+        if((candidates & (candidates - 1)) == 0)
+            _pending[_pendingCount++] = _empty[i];
+    }
+}
+
+template <unsigned int Box>
+bool BasicSolver<Box>::assign(unsigned int cell, unsigned int value)
+{
+    const Mask bit = static_cast<Mask>(Mask{1} << value);
+
+    Assignment& assignment = _assignments[_assignmentCount++];
+    assignment.cell = static_cast<Cell>(cell);
+    assignment.savedCandidates = _candidates[cell];
+    assignment.trailStart = static_cast<uint16_t>(_trailSize);
+
+    _values[cell] = static_cast<uint8_t>(value);
+    _candidates[cell] = bit;
+
+    const unsigned int position = _emptyPosition[cell];
+    const Cell last = _empty[--_emptyCount];
+    _empty[position] = last;
+    _emptyPosition[last] = static_cast<Cell>(position);
+    _empty[_emptyCount] = static_cast<Cell>(cell);
+    _emptyPosition[cell] = static_cast<Cell>(_emptyCount);
+
+    // Written without branches: filled peers hold only their own digit, so the
+    // mask test alone decides whether a peer loses a candidate. The counters
+    // live in locals so the byte stores below cannot force them through memory.
+    unsigned int trailSize = _trailSize;
+    unsigned int pendingCount = _pendingCount;
+    bool consistent = true;
+    for(Cell peer : kGridTables<Box>.peers[cell])
+    {
+        const Mask candidates = _candidates[peer];
+        const bool eliminated = (candidates & bit) != 0;
+        const Mask remaining = static_cast<Mask>(candidates & ~bit);
+        _candidates[peer] = remaining;
+
+        _trail[trailSize] = peer;
+        trailSize += eliminated;
+        _pending[pendingCount] = peer;
+        pendingCount += static_cast<unsigned int>(eliminated & ((remaining & (remaining - 1)) == 0));
+        consistent &= !eliminated | (remaining != 0);
+    }
+    _trailSize = trailSize;
+    _pendingCount = pendingCount;
+
+    return consistent;
+}
+
+template <unsigned int Box>
+void BasicSolver<Box>::undo(unsigned int mark)
+{
+    _pendingCount = 0;
+    while(_assignmentCount > mark)
+    {
+        const Assignment& assignment = _assignments[--_assignmentCount];
+        const unsigned int cell = assignment.cell;
+        const Mask bit = static_cast<Mask>(Mask{1} << _values[cell]);
+
+        while(_trailSize > assignment.trailStart)
+            _candidates[_trail[--_trailSize]] |= bit;
+
+        _candidates[cell] = assignment.savedCandidates;
+        _values[cell] = 0;
+        // Assignments are undone in reverse order, so the cell is still parked
+        // just past the end of the empty list.
+        ++_emptyCount;
+    }
+}
+
+template <unsigned int Box>
+bool BasicSolver<Box>::propagate()
+{
+    if(!_propagationEnabled)
+    {
+        _pendingCount = 0;
+        return true;
+    }
+
+    recordPropagation(_stats);
+    for(;;)
+    {
+        // Naked singles queued by assign() when a peer dropped to one candidate.
+        while(_pendingCount > 0)
+        {
+            const unsigned int cell = _pending[--_pendingCount];
+            if(_values[cell] != 0)
+                continue;
+            const Mask candidates = _candidates[cell];
+            if(candidates == 0 || !assign(cell, std::countr_zero(candidates)))
+                return false;
+        }
+
+        // Hidden singles: a digit missing from a unit that fits in only one of its cells.
+        bool assigned = false;
+        for(const auto& unit : kGridTables<Box>.units)
+        {
+            Mask once = 0;
+            Mask twice = 0;
+            Mask placed = 0;
+            for(Cell cell : unit)
+            {
+                if(_values[cell] != 0)
+                {
+                    placed |= static_cast<Mask>(Mask{1} << _values[cell]);
+                    continue;
+                }
+                twice |= static_cast<Mask>(once & _candidates[cell]);
+                once |= _candidates[cell];
+            }
+
+            if((Shape::kAllDigits & ~placed & ~once) != 0)
+                return false;
+
+            Mask hidden = static_cast<Mask>(once & ~twice);
+            while(hidden != 0)
+            {
+                const unsigned int value = std::countr_zero(hidden);
+                hidden &= static_cast<Mask>(hidden - 1);
+                const Mask bit = static_cast<Mask>(Mask{1} << value);
+
+                for(Cell cell : unit)
+                {
+                    // An earlier single in this pass may already have taken the digit;
+                    // the next pass then reports the contradiction if there is one.
+                    if(_values[cell] != 0 || (_candidates[cell] & bit) == 0)
+                        continue;
+                    if(!assign(cell, value))
+                        return false;
+                    assigned = true;
+                    break;
+                }
+            }
+        }
+
+        if(!assigned && _pendingCount == 0)
+            return true;
+    }
+}
+
+template <unsigned int Box>
+bool BasicSolver<Box>::findBestCell(unsigned int& bestCell, Mask& bestCandidates) const
+{
+    unsigned int bestCount = kDimension + 1;
+    bestCell = kCells;
+    bestCandidates = 0;
+
+    unsigned int i = 0;
+    for(; i < _emptyCount; ++i)
+    {
+        const unsigned int cell = _empty[i];
+        const Mask candidates = _candidates[cell];
+        if(candidates == 0)
+        {
+            recordScan(_stats, i + 1);
+            return false;
+        }
+
+        const unsigned int count = std::popcount(candidates);
+        if(count < bestCount)
+        {
+            bestCount = count;
+            bestCell = cell;
+            bestCandidates = candidates;
+            if(bestCount == 1)
+            {
+                ++i;
+                break;
+            }
+        }
+    }
+
+    recordScan(_stats, i);
+    return true;
+}
+
+template <unsigned int Box>
+template <typename Rng>
+bool BasicSolver<Box>::search(Rng* rng, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    unsigned int cell = kCells;
+    Mask candidateMask = 0;
+    if(!findBestCell(cell, candidateMask))
+        return false;
+
+    if(cell == kCells)
+        return true;
+
+    recordBranch(_stats, static_cast<unsigned int>(std::popcount(candidateMask)));
+
+    // Values come straight off the mask: the lowest first, or with an engine
+    // a random one of those left, which orders them without a shuffle.
+    for(Mask remaining = candidateMask; remaining != 0;)
+    {
+        const unsigned int value = rng != nullptr ? randomSetBit(*rng, remaining)
+                                                  : static_cast<unsigned int>(std::countr_zero(remaining));
+        remaining = static_cast<Mask>(remaining & ~(Mask{1} << value));
+        const unsigned int mark = _assignmentCount;
+        if(assign(cell, value) && propagate() && search(rng, depth + 1))
+            return true;
+        recordBacktrack(_stats);
+        undo(mark);
+    }
+
+    return false;
+}
+
+template <unsigned int Box>
+template <typename Rng>
+bool BasicSolver<Box>::solve(Rng* rng)
+{
+    if(!_consistent)
+        return false;
+
+    // A previous call may have left a solution or cleared the singles queue.
+    _phase = Phase::Idle;
+    undo(0);
+    queueNakedSingles();
+    if(propagate() && search(rng, 0))
+        return true;
+
+    undo(0);
+    return false;
+}
+
+template <unsigned int Box>
+uint64_t BasicSolver<Box>::countImpl(uint64_t limit, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+    if(_sharedTotal != nullptr && (_nodes & kSharedCheckInterval) == 0
+       && _sharedTotal->load(std::memory_order_relaxed) >= _sharedLimit)
+        _stopped = true;
+
+    unsigned int cell = kCells;
+    Mask candidateMask = 0;
+    if(!findBestCell(cell, candidateMask))
+        return 0;
+
+    if(cell == kCells)
+    {
+        if(_sharedTotal != nullptr && ++_unpublished == kPublishInterval)
+            publish();
+        return 1;
+    }
+
+    recordBranch(_stats, std::popcount(candidateMask));
+    uint64_t total = 0;
+    for(Mask mask = candidateMask; mask != 0; mask &= static_cast<Mask>(mask - 1))
+    {
+        const unsigned int mark = _assignmentCount;
+        uint64_t found = 0;
+        if(assign(cell, std::countr_zero(mask)) && propagate())
+            found = countImpl(limit - total, depth + 1);
+        if(found == 0)
+            recordBacktrack(_stats);
+        total += found;
+        undo(mark);
+
+        if(total >= limit || _stopped)
+            return total;
+    }
+
+    return total;
+}
+
+template <unsigned int Box>
+bool BasicSolver<Box>::enumerateImpl(const BasicSolutionVisitor<Box>& visit, uint64_t& visited, unsigned int depth)
+{
+    ++_nodes;
+    recordNode(_stats, depth);
+
+    unsigned int cell = kCells;
+    Mask candidateMask = 0;
+    if(!findBestCell(cell, candidateMask))
+        return true;
+
+    if(cell == kCells)
+    {
+        ++visited;
+        return visit(_values);
+    }
+
+    recordBranch(_stats, std::popcount(candidateMask));
+    for(Mask mask = candidateMask; mask != 0; mask &= static_cast<Mask>(mask - 1))
+    {
+        const unsigned int mark = _assignmentCount;
+        const uint64_t before = visited;
+        bool more = true;
+        if(assign(cell, std::countr_zero(mask)) && propagate())
+            more = enumerateImpl(visit, visited, depth + 1);
+        if(visited == before)
+            recordBacktrack(_stats);
+        undo(mark);
+
+        if(!more)
+            return false;
+    }
+
+    return true;
+}
+
+template <unsigned int Box>
+uint64_t BasicSolver<Box>::enumerate(const BasicSolutionVisitor<Box>& visit)
+{
+    if(!_consistent)
+        return 0;
+
+    _phase = Phase::Idle;
+    undo(0);
+    queueNakedSingles();
+    uint64_t visited = 0;
+    if(propagate())
+        enumerateImpl(visit, visited, 0);
+
+    undo(0);
+    return visited;
+}
+
+template <unsigned int Box>
+typename BasicSolver<Box>::Expansion BasicSolver<Box>::expand()
+{
+    ++_nodes;
+    recordNode(_stats, _frameCount);
+
+    unsigned int cell = kCells;
+    Mask candidateMask = 0;
+    if(!findBestCell(cell, candidateMask))
+        return Expansion::DeadEnd;
+
+    if(cell == kCells)
+    {
+        ++_solutionsFound;
+        return Expansion::Solution;
+    }
+
+    recordBranch(_stats, std::popcount(candidateMask));
+    _frames[_frameCount++] = Frame{static_cast<Cell>(cell), candidateMask, static_cast<uint16_t>(_assignmentCount)};
+    return Expansion::Branch;
+}
+
+template <unsigned int Box>
+SearchStatus BasicSolver<Box>::finishSearch()
+{
+    undo(0);
+    _frameCount = 0;
+    _phase = Phase::Finished;
+    return SearchStatus::Exhausted;
+}
+
+template <unsigned int Box>
+void BasicSolver<Box>::beginSearch()
+{
+    _frameCount = 0;
+    _solutionsFound = 0;
+    _phase = _consistent ? Phase::Start : Phase::Finished;
+}
+
+template <unsigned int Box>
+SearchStatus BasicSolver<Box>::resume(const SearchBudget& budget)
+{
+    if(_phase == Phase::Idle || _phase == Phase::Finished)
+        return SearchStatus::Exhausted;
+    // Checked on entry too: a caller collecting solutions one call at a time
+    // may never run kCheckInterval steps inside a single call.
+    if(budget.cancellation != nullptr && budget.cancellation->isCancelled())
+        return SearchStatus::Cancelled;
+    if(budget.deadline.has_value() && SearchBudget::Clock::now() >= *budget.deadline)
+        return SearchStatus::BudgetExhausted;
+
+    if(_phase == Phase::Start)
+    {
+        _phase = Phase::Running;
+        undo(0);
+        queueNakedSingles();
+        if(!propagate())
+            return finishSearch();
+        const Expansion root = expand();
+        if(root == Expansion::DeadEnd)
+            return finishSearch();
+        if(root == Expansion::Solution)
+            return SearchStatus::Found;
+    }
+
+    // The top frame's undo mark also clears a solution reported by the
+    // previous call, so every pass starts by rewinding to its frame.
+    const uint64_t startNodes = _nodes;
+    uint64_t sinceCheck = 0;
+    while(_frameCount > 0)
+    {
+        if(budget.maxNodes != 0 && _nodes - startNodes >= budget.maxNodes)
+            return SearchStatus::BudgetExhausted;
+        if(++sinceCheck == SearchBudget::kCheckInterval)
+        {
+            sinceCheck = 0;
+            if(budget.cancellation != nullptr && budget.cancellation->isCancelled())
+                return SearchStatus::Cancelled;
+            if(budget.deadline.has_value() && SearchBudget::Clock::now() >= *budget.deadline)
+                return SearchStatus::BudgetExhausted;
+        }
+
+        Frame& frame = _frames[_frameCount - 1];
+        undo(frame.mark);
+        if(frame.remaining == 0)
+        {
+            --_frameCount;
+            continue;
+        }
+
+        const unsigned int value = std::countr_zero(frame.remaining);
+        frame.remaining &= static_cast<Mask>(frame.remaining - 1);
+        const Expansion child = assign(frame.cell, value) && propagate() ? expand() : Expansion::DeadEnd;
+        if(child == Expansion::Solution)
+            return SearchStatus::Found;
+        if(child == Expansion::DeadEnd)
+            recordBacktrack(_stats);
+    }
+
+    return finishSearch();
+}
+
+template <unsigned int Box>
+void BasicSolver<Box>::publish()
+{
+    const uint64_t after = _sharedTotal->fetch_add(_unpublished, std::memory_order_relaxed) + _unpublished;
+    _unpublished = 0;
+    if(after >= _sharedLimit)
+        _stopped = true;
+}
+
+template <unsigned int Box>
+uint64_t BasicSolver<Box>::count(uint64_t limit)
+{
+    if(limit == 0 || !_consistent)
+        return 0;
+
+    _phase = Phase::Idle;
+    undo(0);
+    queueNakedSingles();
+    uint64_t total = 0;
+    if(propagate())
+        total = countImpl(limit, 0);
+
+    undo(0);
+    return total;
+}
+
+template <unsigned int Box>
+uint64_t BasicSolver<Box>::countShared(std::atomic<uint64_t>& sharedTotal, uint64_t limit)
+{
+    _sharedTotal = &sharedTotal;
+    _sharedLimit = limit;
+    _unpublished = 0;
+    _stopped = sharedTotal.load(std::memory_order_relaxed) >= limit;
+
+    const uint64_t total = _stopped ? 0 : count(limit);
+    if(_unpublished != 0)
+        publish();
+
+    _sharedTotal = nullptr;
+    _stopped = false;
+    return total;
+}
+
+template <unsigned int Box>
+bool BasicSolver<Box>::hasSolutionExcluding(unsigned int cell, unsigned int value)
+{
+    _phase = Phase::Idle;
+    undo(0);
+    if(!_consistent)
+        return false;
+
+    const Mask saved = _candidates[cell];
+    const Mask remaining = static_cast<Mask>(saved & ~(Mask{1} << value));
+    if(_values[cell] != 0 || remaining == 0)
+        return false;
+
+    // Both the puzzle and the cell's reduced candidates may have changed since
+    // load(), so the singles queue is rebuilt from the empty list.
+    _candidates[cell] = remaining;
+    queueNakedSingles();
+    const bool found = propagate() && search<RandomEngine>(nullptr, 0);
+
+    undo(0);
+    _candidates[cell] = saved;
+    return found;
+}
+
+template class sudoku::BasicSolver<3>;
+template class sudoku::BasicSolver<4>;
+template class sudoku::BasicSolver<5>;
+
+template bool sudoku::BasicSolver<3>::solve(Xoshiro256PlusPlus*);
+template bool sudoku::BasicSolver<4>::solve(Xoshiro256PlusPlus*);
+template bool sudoku::BasicSolver<5>::solve(Xoshiro256PlusPlus*);
+template bool sudoku::BasicSolver<3>::solve(Pcg32*);
+template bool sudoku::BasicSolver<4>::solve(Pcg32*);
+template bool sudoku::BasicSolver<5>::solve(Pcg32*);
@@ -0,0 +1,119 @@
+#include <random>
+#include <vector>
+#include "SolverContext.h"
+
+using namespace sudoku;
+
+namespace {
+
+template <unsigned int Box, typename Rng>
+struct ContextPool
+{
+    explicit ContextPool(bool& closedFlag)
+        : closed(closedFlag)
+    {
+        idle.reserve(BasicSolverContext<Box, Rng>::kPoolCapacity);
+    }
+
+    // Boards destroyed after the pool (during thread exit) free their
+    // contexts instead of parking them here.
+    ~ContextPool() { closed = true; }
+
+    bool& closed;
+    std::vector<std::unique_ptr<BasicSolverContext<Box, Rng>>> idle;
+};
+
+template <unsigned int Box, typename Rng>
+ContextPool<Box, Rng>* localPool()
+{
+    // The flag is trivially destructible, so it stays readable after the
+    // pool itself is gone.
+    thread_local bool closed = false;
+    if(closed)
+        return nullptr;
+    thread_local ContextPool<Box, Rng> pool(closed);
+    return &pool;
+}
+
+// Seeds for unseeded leases: one std::random_device read per thread, then a
+// counter mixed through SplitMix64. A reused context never carries the
+// previous lessee's stream (which may have been seeded) into a new board.
+uint32_t freshSeed()
+{
+    thread_local const uint64_t entropy = (uint64_t{std::random_device{}()} << 32) | std::random_device{}();
+    thread_local uint64_t leases = 0;
+    return deriveSeed(entropy, leases++);
+}
+
+} // namespace
+
+template <unsigned int Box, typename Rng>
+BasicSolverContext<Box, Rng>::BasicSolverContext(std::optional<uint32_t> seed)
+    : _rng(seed.has_value() ? seed.value() : std::random_device{}())
+{
+}
+
+template <unsigned int Box, typename Rng>
+uint64_t BasicSolverContext<Box, Rng>::lastSearchNodes() const
+{
+    if constexpr(Box == 3)
+    {
+        if(_lastBackend == SolverBackend::Bitboard)
+            return _bitboardSolver.nodes();
+    }
+    return _lastBackend == SolverBackend::Dlx ? _dlxSolver.nodes() : _solver.nodes();
+}
+
+template <unsigned int Box, typename Rng>
+void BasicSolverContext<Box, Rng>::setSearchStats(SearchStats* stats)
+{
+    _solver.setSearchStats(stats);
+    _dlxSolver.setSearchStats(stats);
+    if constexpr(Box == 3)
+        _bitboardSolver.setSearchStats(stats);
+}
+
+template <unsigned int Box, typename Rng>
+void BasicSolverContext<Box, Rng>::resetSettings()
+{
+    _solver.setPropagationEnabled(true);
+    setSearchStats(nullptr);
+    _lastBackend = SolverBackend::Mrv;
+}
+
+template <unsigned int Box, typename Rng>
+std::unique_ptr<BasicSolverContext<Box, Rng>> BasicSolverContext<Box, Rng>::acquire(std::optional<uint32_t> seed)
+{
+    const uint32_t leaseSeed = seed.has_value() ? *seed : freshSeed();
+    ContextPool<Box, Rng>* pool = localPool<Box, Rng>();
+    if(pool == nullptr || pool->idle.empty())
+        return std::make_unique<BasicSolverContext>(leaseSeed);
+
+    std::unique_ptr<BasicSolverContext> context = std::move(pool->idle.back());
+    pool->idle.pop_back();
+    context->resetSettings();
+    context->rng().seed(leaseSeed);
+    return context;
+}
+
+template <unsigned int Box, typename Rng>
+void BasicSolverContext<Box, Rng>::release(std::unique_ptr<BasicSolverContext> context)
+{
+    ContextPool<Box, Rng>* pool = localPool<Box, Rng>();
+    if(context != nullptr && pool != nullptr && pool->idle.size() < kPoolCapacity)
+        pool->idle.push_back(std::move(context));
+}
+
+template <unsigned int Box, typename Rng>
+std::size_t BasicSolverContext<Box, Rng>::pooled()
+{
+    ContextPool<Box, Rng>* pool = localPool<Box, Rng>();
+    return pool == nullptr ? 0 : pool->idle.size();
+}
+
+template class sudoku::BasicSolverContext<3>;
+template class sudoku::BasicSolverContext<4>;
+template class sudoku::BasicSolverContext<5>;
+template class sudoku::BasicSolverContext<3, Pcg32>;
+template class sudoku::BasicSolverContext<4, Pcg32>;
+template class sudoku::BasicSolverContext<5, Pcg32>;
@@ -0,0 +1,84 @@
+#include "WorkerPool.h"
+
+using namespace sudoku;
+
+WorkerPool::WorkerPool(unsigned int threadCount)
+{
+    if(threadCount == 0)
+        threadCount = 1;
+
+    _threads.reserve(threadCount);
+    for(unsigned int worker = 0; worker < threadCount; ++worker)
+        _threads.emplace_back(&WorkerPool::workerLoop, this, worker);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+
+    for(std::thread& thread : _threads)
+        thread.join();
+}
+
+unsigned int WorkerPool::size() const
+{
+    return static_cast<unsigned int>(_threads.size());
+}
+
+unsigned int WorkerPool::defaultThreadCount()
+{
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+void WorkerPool::run(std::size_t count, const Task& task)
+{
+    if(count == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _task = &task;
+    _count = count;
+    _next.store(0, std::memory_order_relaxed);
+    _active = size();
+    ++_generation;
+    _wake.notify_all();
+
+    _done.wait(lock, [this] { return _active == 0; });
+    _task = nullptr;
+}
+
+void WorkerPool::workerLoop(unsigned int worker)
+{
+    uint64_t seenGeneration = 0;
+
+    for(;;)
+    {
+        const Task* task = nullptr;
+        std::size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [&] { return _stopping || _generation != seenGeneration; });
+            if(_stopping)
+                return;
+            seenGeneration = _generation;
+            task = _task;
+            count = _count;
+        }
+
+        for(std::size_t item = _next.fetch_add(1, std::memory_order_relaxed);
+            item < count;
+            item = _next.fetch_add(1, std::memory_order_relaxed))
+        {
+            (*task)(worker, item);
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(--_active == 0)
+            _done.notify_one();
+    }
+}
@@ -5,31 +5,720 @@
 //  Created by Marcin on 23/10/2022.
 //
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <random>
+#include <span>
 #include <string>
+#include <vector>
+#include "BatchSolver.h"
 #include "Board.h"
+#include "Canonical.h"
+#include "PackedCorpus.h"
+#include "ParallelCounter.h"
 #include "ParseUtils.h"
+#include "Random.h"
+#include "Server.h"
+#include "SolutionSampler.h"
+#include "SolveCache.h"
+#include "WorkerPool.h"
 
 using namespace sudoku;
 
 namespace {
 
+struct Options
+{
+    unsigned int size = 9;
+    std::optional<unsigned int> clues;
+    bool solutionOnly = false;
+    std::optional<uint32_t> seed;
+    std::optional<std::string> solvePath;
+    std::optional<std::string> countPath;
+    std::optional<std::string> gradePath;
+    std::optional<std::string> packedOutPath;
+    std::optional<Difficulty> difficulty;
+    uint64_t limit = 2;
+    std::optional<unsigned int> count;
+    unsigned int threads = WorkerPool::defaultThreadCount();
+    SolverBackend backend = SolverBackend::Mrv;
+    bool backendSet = false;
+    bool searchStats = false;
+    bool dedup = false;
+    std::size_t cacheSize = 0;
+    bool serve = false;
+    std::optional<std::string> socketPath;
+    uint64_t timeoutMs = 0;
+    bool lanes = false;
+    uint64_t samplePool = 0;
+    uint64_t freshEvery = 0;
+};
+
+bool parseBackend(const std::string& text, SolverBackend& backend)
+{
+    if(text == "mrv")
+        backend = SolverBackend::Mrv;
+    else if(text == "dlx")
+        backend = SolverBackend::Dlx;
+    else if(text == "bitboard")
+        backend = SolverBackend::Bitboard;
+    else
+        return false;
+    return true;
+}
+
 void printUsage(const char* program)
 {
-    std::cout << "Usage: " << program << " [--clues N] [--seed N] [--solution]\n";
-    std::cout << "  --clues N     Number of given cells (default 30)\n";
+    std::cout << "Usage: " << program << " [--size N] [--clues N | --difficulty D] [--seed N] [--solution] [--backend B] [--packed-out FILE]\n";
+    std::cout << "       " << program << " [--size N] --count N [--threads N] [--clues N | --difficulty D] [--seed N] [--solution] [--backend B] [--packed-out FILE] [--dedup]\n";
+    std::cout << "       " << program << " --count N --solution --sample-pool N [--fresh-every N] [--seed N] [--backend B] [--packed-out FILE]\n";
+    std::cout << "       " << program << " [--size N] --solve FILE [--threads N] [--packed-out FILE] [[--backend B] [--stats | --cache N] | --lanes]\n";
+    std::cout << "       " << program << " [--size N] --count-solutions FILE [--limit N] [--threads N] [--stats]\n";
+    std::cout << "       " << program << " [--size N] --grade FILE\n";
+    std::cout << "       " << program << " --serve | --serve-socket PATH [--threads N] [--backend B] [--cache N] [--timeout-ms N] [--seed N]\n";
+    std::cout << "  --size N      Board size: 9, 16 or 25 (default 9)\n";
+    std::cout << "  --clues N     Number of given cells (default 30 for 9x9, 110 for 16x16, 300 for 25x25)\n";
+    std::cout << "  --difficulty D\n";
+    std::cout << "                Generate a puzzle of tier easy, medium, hard, expert or extreme\n";
     std::cout << "  --seed N      Deterministic seed for generation\n";
     std::cout << "  --solution    Print a full solved board\n";
+    std::cout << "  --count N     Generate N boards in parallel, one line each\n";
+    std::cout << "  --solve FILE  Solve puzzles, one per line ('-' reads stdin) or from a packed corpus\n";
+    std::cout << "  --packed-out FILE\n";
+    std::cout << "                Write generated or solved boards to FILE as a packed binary corpus\n";
+    std::cout << "  --count-solutions FILE\n";
+    std::cout << "                Count solutions of each puzzle, one per line ('-' reads stdin)\n";
+    std::cout << "  --grade FILE  Rate each puzzle by the techniques it needs, one per line ('-' reads stdin)\n";
+    std::cout << "  --limit N     Stop counting a puzzle at N solutions (default 2)\n";
+    std::cout << "  --threads N   Worker threads for --count, --solve and --count-solutions (default: all cores)\n";
+    std::cout << "  --backend B   Search engine: mrv, dlx or bitboard (default mrv; bitboard is 9x9 only)\n";
+    std::cout << "  --dedup       With --count, drop boards equivalent under symmetry to an earlier one (9x9 only)\n";
+    std::cout << "  --sample-pool N\n";
+    std::cout << "                With --count and --solution, transform N searched seed grids instead of\n";
+    std::cout << "                searching for every grid (9x9 only, one thread)\n";
+    std::cout << "  --fresh-every N\n";
+    std::cout << "                With --sample-pool, replace the oldest seed with a new search every N grids\n";
+    std::cout << "  --lanes       With --solve, solve 8-16 puzzles at once across SIMD lanes (9x9 only,\n";
+    std::cout << "                not with --backend, --stats or --cache)\n";
+    std::cout << "  --cache N     Answer --solve from a cache of N puzzles keyed by canonical form (9x9 only)\n";
+    std::cout << "  --serve       Answer generate, solve, count and validate requests, one per line, from stdin\n";
+    std::cout << "  --serve-socket PATH\n";
+    std::cout << "                Answer the same requests on a Unix domain socket at PATH\n";
+    std::cout << "  --timeout-ms N\n";
+    std::cout << "                With --serve, answer solve, count and validate with \"error timeout\" after N ms\n";
+    std::cout << "  --stats       Print search statistics for each puzzle of --solve or --count-solutions to stderr\n";
+}
+
+constexpr std::size_t kSolveBatchSize = 16384;
+// Puzzles per BatchSolver call with --lanes: enough to keep every lane busy
+// while leaving a batch in several chunks for the workers to share.
+constexpr std::size_t kLaneChunkSize = 1024;
+constexpr std::size_t kGenerateBatchSize = 4096;
+constexpr unsigned int kMaxGenerateAttempts = 1000;
+
+template <unsigned int Box>
+unsigned int defaultClues()
+{
+    switch(Box)
+    {
+        case 4: return 110;
+        case 5: return 300;
+        default: return 30;
+    }
+}
+
+void printSearchStats(uint64_t puzzle, const SearchStats& stats)
+{
+    std::cerr << "puzzle " << puzzle << ": " << stats << "\n";
+}
+
+// Reads puzzles in fixed-size batches, solves each batch on the worker pool with
+// one board per worker and writes results in input order. Puzzles come from
+// text lines or, when packedInput is set, straight from the mapped corpus;
+// solutions go out as text lines or as packed records. With searchStats set,
+// each puzzle's SearchStats follow on stderr, also in input order. With a
+// cache, puzzles equivalent to one seen before skip the search. With lanes,
+// each worker solves chunks of the batch on a BatchSolver instead.
+template <unsigned int Box>
+int runSolve(std::istream* input, const PackedReader* packedInput, PackedWriter* packedOutput,
+             unsigned int threads, SolverBackend backend, bool searchStats, SolveCache* cache, bool lanes)
+{
+    using GridType = BasicGrid<Box>;
+    constexpr std::size_t kSolvedLineLength = Geometry<Box>::kCells + 1;
+
+    WorkerPool pool(threads);
+    std::vector<BasicBoard<Box>> boards(pool.size());
+    for(BasicBoard<Box>& board : boards)
+        board.setSearchStatsEnabled(searchStats);
+
+    std::vector<std::string> lines(packedInput == nullptr ? kSolveBatchSize : 0);
+    std::vector<std::string> results(packedOutput == nullptr ? kSolveBatchSize : 0);
+    // Unsolved puzzles are written as empty records.
+    std::vector<GridType> solved(packedOutput != nullptr ? kSolveBatchSize : 0);
+    std::vector<SearchStats> stats(searchStats ? kSolveBatchSize : 0);
+    std::vector<BatchSolver> batchSolvers(lanes ? pool.size() : 0);
+    std::vector<Grid> puzzles(lanes ? kSolveBatchSize : 0);
+    std::vector<BatchOutcome> outcomes(lanes ? kSolveBatchSize : 0);
+    std::vector<uint8_t> valid(lanes ? kSolveBatchSize : 0);
+
+    uint64_t total = 0;
+    std::atomic<uint64_t> failed{0};
+    auto start = std::chrono::steady_clock::now();
+
+    bool more = true;
+    while(more)
+    {
+        std::size_t batch = 0;
+        if(packedInput != nullptr)
+        {
+            batch = static_cast<std::size_t>(std::min<uint64_t>(kSolveBatchSize, packedInput->size() - total));
+            more = total + batch < packedInput->size();
+        }
+        else
+        {
+            while(batch < kSolveBatchSize && std::getline(*input, lines[batch]))
+            {
+                std::string& line = lines[batch];
+                if(!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if(!line.empty())
+                    ++batch;
+            }
+            more = batch == kSolveBatchSize;
+        }
+
+        const uint64_t first = total;
+        auto loadItem = [&](BasicBoard<Box>& board, std::size_t item) {
+            if(packedInput == nullptr)
+                return board.loadFromString(lines[item]);
+            GridType puzzle{};
+            return packedInput->read<Box>(first + item, puzzle) && board.loadFromData(puzzle);
+        };
+        // Writes the board, which holds the solution when solvedBoard is set.
+        auto storeItem = [&](const BasicBoard<Box>& board, std::size_t item, bool loaded, bool solvedBoard) {
+            if(!solvedBoard)
+                failed.fetch_add(1, std::memory_order_relaxed);
+            if(packedOutput != nullptr)
+                solved[item] = solvedBoard ? board.getBoardData() : GridType{};
+            else if(solvedBoard)
+                results[item] = board.toString();
+            else
+                results[item].assign(loaded ? "unsolvable" : "invalid");
+        };
+
+        if(lanes)
+        {
+            // Lanes are 9x9 only; main() rejects --lanes for other sizes.
+            if constexpr(Box == 3)
+            {
+                pool.run((batch + kLaneChunkSize - 1) / kLaneChunkSize, [&](unsigned int worker, std::size_t chunk) {
+                    BasicBoard<Box>& board = boards[worker];
+                    const std::size_t begin = chunk * kLaneChunkSize;
+                    const std::size_t size = std::min(kLaneChunkSize, batch - begin);
+                    for(std::size_t item = begin; item < begin + size; ++item)
+                    {
+                        // An out-of-range digit makes the solver skip the
+                        // puzzle, so invalid input costs no search.
+                        valid[item] = loadItem(board, item);
+                        puzzles[item] = board.getBoardData();
+                        if(!valid[item])
+                            puzzles[item][0] = 0xFF;
+                    }
+                    batchSolvers[worker].solve(std::span(puzzles).subspan(begin, size),
+                                               std::span(outcomes).subspan(begin, size));
+                    for(std::size_t item = begin; item < begin + size; ++item)
+                    {
+                        const bool solvedBoard = outcomes[item].solutions != 0 && board.loadFromData(outcomes[item].solution);
+                        storeItem(board, item, valid[item] != 0, solvedBoard);
+                    }
+                });
+            }
+        }
+        else
+        {
+            pool.run(batch, [&](unsigned int worker, std::size_t item) {
+                BasicBoard<Box>& board = boards[worker];
+                const bool loaded = loadItem(board, item);
+
+                bool solvedBoard = false;
+                if constexpr(Box == 3)
+                {
+                    if(loaded && cache != nullptr)
+                    {
+                        const SolveResult result = cache->solve(board.getBoardData(), board, backend);
+                        solvedBoard = result.status != SolveStatus::Unsolvable && board.loadFromData(result.solution);
+                    }
+                    else
+                    {
+                        solvedBoard = loaded && board.solve(backend);
+                    }
+                }
+                else
+                {
+                    solvedBoard = loaded && board.solve(backend);
+                }
+                if(searchStats)
+                    stats[item] = loaded ? board.getLastSearchStats() : SearchStats{};
+                storeItem(board, item, loaded, solvedBoard);
+            });
+        }
+
+        if(packedOutput != nullptr)
+        {
+            for(std::size_t item = 0; item < batch; ++item)
+                packedOutput->write<Box>(solved[item]);
+        }
+        else
+        {
+            std::string output;
+            output.reserve(batch * kSolvedLineLength);
+            for(std::size_t item = 0; item < batch; ++item)
+            {
+                output.append(results[item]);
+                output.push_back('\n');
+            }
+            std::cout.write(output.data(), static_cast<std::streamsize>(output.size()));
+        }
+        for(std::size_t item = 0; item < stats.size() && item < batch; ++item)
+            printSearchStats(first + item + 1, stats[item]);
+        total += batch;
+    }
+    std::cout.flush();
+
+    const uint64_t unsolved = failed.load();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double seconds = elapsed.count();
+    std::cerr << "Solved " << (total - unsolved) << "/" << total << " puzzles in " << seconds << " s";
+    if(seconds > 0.0)
+        std::cerr << " (" << static_cast<uint64_t>(static_cast<double>(total) / seconds) << " puzzles/sec)";
+    std::cerr << " on " << pool.size() << " threads\n";
+    if(cache != nullptr)
+    {
+        const SolveCacheCounters counters = cache->counters();
+        std::cerr << "Cache: " << counters.hits << " hits, " << counters.misses << " misses, "
+                  << counters.evictions << " evictions\n";
+    }
+
+    return unsolved == 0 ? 0 : 2;
+}
+
+// Counts the solutions of each puzzle in turn, every count spread over all
+// threads by the work-stealing counter.
+template <unsigned int Box>
+int runCountSolutions(std::istream& input, unsigned int threads, uint64_t limit, bool searchStats)
+{
+    BasicParallelCounter<Box> counter(threads);
+    counter.setSearchStatsEnabled(searchStats);
+    BasicBoard<Box> board;
+
+    uint64_t total = 0;
+    uint64_t invalid = 0;
+    uint64_t nodes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::string line;
+    while(std::getline(input, line))
+    {
+        if(!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if(line.empty())
+            continue;
+
+        ++total;
+        if(!board.loadFromString(line))
+        {
+            std::cout << "invalid\n";
+            ++invalid;
+            continue;
+        }
+        std::cout << counter.count(board.getBoardData(), limit) << "\n";
+        nodes += counter.nodes();
+        if(searchStats)
+            printSearchStats(total, counter.searchStats());
+    }
+    std::cout.flush();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cerr << "Counted " << (total - invalid) << "/" << total << " puzzles in " << elapsed.count() << " s, "
+              << nodes << " nodes on " << counter.threadCount() << " threads\n";
+
+    return invalid == 0 ? 0 : 2;
+}
+
+// Rates each puzzle in turn; grading is cheap enough to need no worker pool.
+template <unsigned int Box>
+int runGrade(std::istream& input)
+{
+    BasicBoard<Box> board;
+    BasicGrader<Box> grader;
+
+    uint64_t total = 0;
+    uint64_t invalid = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::string output;
+    std::string line;
+    while(std::getline(input, line))
+    {
+        if(!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if(line.empty())
+            continue;
+
+        ++total;
+        if(!board.loadFromString(line))
+        {
+            output.append("invalid\n");
+            ++invalid;
+            continue;
+        }
+        output.append(difficultyName(grader.grade(board.getBoardData())));
+        output.push_back('\n');
+    }
+    std::cout.write(output.data(), static_cast<std::streamsize>(output.size()));
+    std::cout.flush();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double seconds = elapsed.count();
+    std::cerr << "Graded " << (total - invalid) << "/" << total << " puzzles in " << seconds << " s";
+    if(seconds > 0.0)
+        std::cerr << " (" << static_cast<uint64_t>(static_cast<double>(total) / seconds) << " puzzles/sec)";
+    std::cerr << "\n";
+
+    return invalid == 0 ? 0 : 2;
+}
+
+// Work summed over every generatePuzzle call of a run.
+struct GenerateTotals
+{
+    std::atomic<uint64_t> attempts{0};
+    std::atomic<uint64_t> repairSteps{0};
+    std::atomic<uint64_t> uniquenessChecks{0};
+};
+
+template <unsigned int Box>
+bool generateWithRetries(BasicBoard<Box>& board, const Options& options, unsigned int clues, GenerateTotals& totals)
+{
+    for(unsigned int attempt = 0; attempt < kMaxGenerateAttempts; ++attempt)
+    {
+        totals.attempts.fetch_add(1, std::memory_order_relaxed);
+        if(options.solutionOnly)
+        {
+            if(board.generateSolution(options.backend))
+                return true;
+        }
+        else
+        {
+            const bool generated = options.difficulty.has_value()
+                ? board.generatePuzzle(*options.difficulty, options.backend)
+                : board.generatePuzzle(clues, options.backend);
+            const GenerationStats& stats = board.getLastGenerationStats();
+            totals.repairSteps.fetch_add(stats.repairSteps, std::memory_order_relaxed);
+            totals.uniquenessChecks.fetch_add(stats.uniquenessChecks, std::memory_order_relaxed);
+            if(generated)
+                return true;
+        }
+    }
+    return false;
+}
+
+// Generates options.count boards on the worker pool. Task i is seeded with
+// deriveSeed(master, i), and a task's line is written as soon as it and every
+// earlier task have finished, so the output does not depend on the thread count.
+// With options.dedup, tasks canonicalize their boards in parallel and the
+// writer drops any board whose canonical grid it has already written; that
+// check runs in task order too, so the surviving boards are deterministic.
+template <unsigned int Box>
+int runGenerateBatch(const Options& options, unsigned int clues, PackedWriter* packedOutput)
+{
+    const uint64_t masterSeed = options.seed.has_value() ? *options.seed : std::random_device{}();
+    const std::size_t total = *options.count;
+
+    WorkerPool pool(options.threads);
+    std::vector<BasicBoard<Box>> boards(pool.size());
+
+    std::vector<std::string> results(packedOutput == nullptr ? kGenerateBatchSize : 0);
+    // Failed tasks are written as empty records.
+    std::vector<BasicGrid<Box>> grids(packedOutput != nullptr ? kGenerateBatchSize : 0);
+    // Canonical grid of each board; left empty for failed tasks.
+    std::vector<Grid> canonical(options.dedup ? kGenerateBatchSize : 0);
+    std::vector<uint8_t> finished(kGenerateBatchSize);
+    DedupIndex index;
+    std::mutex outputMutex;
+    std::atomic<uint64_t> failed{0};
+    uint64_t duplicates = 0;
+    GenerateTotals totals;
+    auto start = std::chrono::steady_clock::now();
+
+    for(std::size_t first = 0; first < total; first += kGenerateBatchSize)
+    {
+        const std::size_t batch = std::min(kGenerateBatchSize, total - first);
+        std::fill(finished.begin(), finished.begin() + static_cast<std::ptrdiff_t>(batch), 0);
+        std::size_t nextToWrite = 0;
+
+        pool.run(batch, [&](unsigned int worker, std::size_t item) {
+            BasicBoard<Box>& board = boards[worker];
+            board.setSeed(deriveSeed(masterSeed, first + item));
+            const bool generated = generateWithRetries(board, options, clues, totals);
+            if(!generated)
+                failed.fetch_add(1, std::memory_order_relaxed);
+
+            std::string result;
+            if(packedOutput == nullptr)
+                result = generated ? board.toString() : std::string("failed");
+            if constexpr(Box == 3)
+            {
+                if(options.dedup)
+                    canonical[item] = generated ? canonicalize(board.getBoardData()).grid : Grid{};
+            }
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if(packedOutput != nullptr)
+                grids[item] = generated ? board.getBoardData() : BasicGrid<Box>{};
+            else
+                results[item] = std::move(result);
+            finished[item] = 1;
+            while(nextToWrite < batch && finished[nextToWrite] != 0)
+            {
+                if(options.dedup && canonical[nextToWrite] != Grid{} && !index.insertCanonical(canonical[nextToWrite]))
+                {
+                    ++duplicates;
+                    ++nextToWrite;
+                    continue;
+                }
+                if(packedOutput != nullptr)
+                {
+                    packedOutput->write<Box>(grids[nextToWrite++]);
+                    continue;
+                }
+                std::string& line = results[nextToWrite++];
+                line.push_back('\n');
+                std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+            }
+        });
+        std::cout.flush();
+    }
+
+    const uint64_t unfinished = failed.load();
+    // Dropped duplicates count as attempts, not as generated boards.
+    const uint64_t written = total - unfinished - duplicates;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double seconds = elapsed.count();
+    std::cerr << "Generated " << written << "/" << total << " boards in " << seconds << " s";
+    if(seconds > 0.0)
+        std::cerr << " (" << static_cast<uint64_t>(static_cast<double>(written) / seconds) << " boards/sec)";
+    std::cerr << " on " << pool.size() << " threads, master seed " << masterSeed << "\n";
+    if(options.dedup)
+        std::cerr << duplicates << " duplicates dropped\n";
+    if(!options.solutionOnly)
+    {
+        std::cerr << totals.attempts.load() << " attempts, " << totals.repairSteps.load() << " repair steps, "
+                  << totals.uniquenessChecks.load() << " uniqueness checks\n";
+    }
+
+    return unfinished == 0 ? 0 : 1;
+}
+
+// Draws options.count solved grids from a SolutionSampler on this thread,
+// writing each chunk as it is filled. One thread keeps the output a function
+// of the seed alone, and a transform is cheaper than writing its line.
+int runSampleSolutions(const Options& options, PackedWriter* packedOutput)
+{
+    const uint32_t masterSeed = options.seed.has_value() ? *options.seed : std::random_device{}();
+    const std::size_t total = *options.count;
+    auto start = std::chrono::steady_clock::now();
+
+    SolutionSampler::Options samplerOptions;
+    samplerOptions.poolSize = static_cast<std::size_t>(options.samplePool);
+    samplerOptions.freshInterval = options.freshEvery;
+    samplerOptions.backend = options.backend;
+    SolutionSampler sampler(masterSeed, samplerOptions);
+
+    std::vector<Grid> grids(kGenerateBatchSize);
+    std::string text;
+    for(std::size_t first = 0; first < total; first += kGenerateBatchSize)
+    {
+        const std::span<Grid> batch(grids.data(), std::min(kGenerateBatchSize, total - first));
+        sampler.fill(batch);
+        if(packedOutput != nullptr)
+        {
+            for(const Grid& grid : batch)
+                packedOutput->write<3>(grid);
+            continue;
+        }
+        text.clear();
+        for(const Grid& grid : batch)
+        {
+            for(uint8_t value : grid)
+                text.push_back(static_cast<char>('0' + value));
+            text.push_back('\n');
+        }
+        std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    std::cout.flush();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double seconds = elapsed.count();
+    std::cerr << "Sampled " << total << " grids in " << seconds << " s";
+    if(seconds > 0.0)
+        std::cerr << " (" << static_cast<uint64_t>(static_cast<double>(total) / seconds) << " grids/sec)";
+    std::cerr << " from " << sampler.searchedSeeds() << " searched seeds, master seed " << masterSeed << "\n";
+    return 0;
+}
+
+template <unsigned int Box>
+int runGenerate(const Options& options, PackedWriter* packedOutput)
+{
+    if constexpr(Box == 3)
+    {
+        if(options.samplePool != 0)
+            return runSampleSolutions(options, packedOutput);
+    }
+
+    const unsigned int clues = options.clues.value_or(defaultClues<Box>());
+    if(options.count.has_value())
+        return runGenerateBatch<Box>(options, clues, packedOutput);
+
+    std::unique_ptr<BasicBoard<Box>> board = std::make_unique<BasicBoard<Box>>(options.seed);
+    GenerateTotals totals;
+    if(!generateWithRetries(*board, options, clues, totals))
+    {
+        std::cerr << "Failed to generate board after " << kMaxGenerateAttempts << " attempts\n";
+        return 1;
+    }
+
+    if(packedOutput != nullptr)
+        packedOutput->write<Box>(board->getBoardData());
+    else
+        std::cout << *board;
+
+    return 0;
+}
+
+// Serves requests until stdin closes, or on a socket until the process is
+// stopped. Engines are built once, before the first request.
+int runServer(const Options& options)
+{
+    RequestServer::Options serverOptions;
+    serverOptions.threads = options.threads;
+    serverOptions.backend = options.backend;
+    serverOptions.cacheSize = options.cacheSize;
+    serverOptions.searchTimeout = std::chrono::milliseconds(options.timeoutMs);
+    serverOptions.masterSeed = options.seed.has_value() ? *options.seed : std::random_device{}();
+    RequestServer server(serverOptions);
+
+    if(!options.socketPath.has_value())
+    {
+        std::ios::sync_with_stdio(false);
+        server.serve(std::cin, std::cout);
+        return 0;
+    }
+
+    std::cerr << "Serving on " << *options.socketPath << " with " << server.size() << " threads\n";
+    if(!server.serveUnixSocket(*options.socketPath))
+    {
+        std::cerr << "Cannot listen on " << *options.socketPath << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+template <unsigned int Box>
+int run(const Options& options)
+{
+    if(options.gradePath.has_value())
+    {
+        std::ios::sync_with_stdio(false);
+        if(*options.gradePath == "-")
+            return runGrade<Box>(std::cin);
+
+        std::ifstream file(*options.gradePath);
+        if(!file)
+        {
+            std::cerr << "Cannot open " << *options.gradePath << "\n";
+            return 1;
+        }
+        return runGrade<Box>(file);
+    }
+
+    if(options.countPath.has_value())
+    {
+        std::ios::sync_with_stdio(false);
+        if(*options.countPath == "-")
+            return runCountSolutions<Box>(std::cin, options.threads, options.limit, options.searchStats);
+
+        std::ifstream file(*options.countPath);
+        if(!file)
+        {
+            std::cerr << "Cannot open " << *options.countPath << "\n";
+            return 1;
+        }
+        return runCountSolutions<Box>(file, options.threads, options.limit, options.searchStats);
+    }
+
+    PackedWriter packedOutput;
+    if(options.packedOutPath.has_value() && !packedOutput.open(*options.packedOutPath, Geometry<Box>::kDimension))
+    {
+        std::cerr << "Cannot create " << *options.packedOutPath << "\n";
+        return 1;
+    }
+    PackedWriter* output = options.packedOutPath.has_value() ? &packedOutput : nullptr;
+    std::unique_ptr<SolveCache> cache;
+    if(options.cacheSize != 0)
+        cache = std::make_unique<SolveCache>(options.cacheSize);
+
+    int result = 0;
+    if(!options.solvePath.has_value())
+    {
+        result = runGenerate<Box>(options, output);
+    }
+    else if(*options.solvePath == "-")
+    {
+        std::ios::sync_with_stdio(false);
+        result = runSolve<Box>(&std::cin, nullptr, output, options.threads, options.backend, options.searchStats, cache.get(), options.lanes);
+    }
+    else if(PackedReader::isPackedFile(*options.solvePath))
+    {
+        PackedReader input;
+        if(!input.open(*options.solvePath) || input.dimension() != Geometry<Box>::kDimension)
+        {
+            std::cerr << "Cannot read " << *options.solvePath << " as a packed " << Geometry<Box>::kDimension
+                      << "x" << Geometry<Box>::kDimension << " corpus\n";
+            return 1;
+        }
+        result = runSolve<Box>(nullptr, &input, output, options.threads, options.backend, options.searchStats, cache.get(), options.lanes);
+    }
+    else
+    {
+        std::ios::sync_with_stdio(false);
+        std::ifstream file(*options.solvePath);
+        if(!file)
+        {
+            std::cerr << "Cannot open " << *options.solvePath << "\n";
+            return 1;
+        }
+        result = runSolve<Box>(&file, nullptr, output, options.threads, options.backend, options.searchStats, cache.get(), options.lanes);
+    }
+
+    if(output != nullptr && !packedOutput.close())
+    {
+        std::cerr << "Failed to write " << *options.packedOutPath << "\n";
+        return 1;
+    }
+    return result;
 }
 
 } // namespace
 
 int main(int argc, const char * argv[]) {
-    unsigned int clues = 30;
-    bool solutionOnly = false;
-    std::optional<uint32_t> seed;
+    Options options;
 
     for(int i = 1; i < argc; ++i)
     {
@@ -41,7 +730,49 @@ int main(int argc, const char * argv[]) {
         }
         if(arg == "--solution")
         {
-            solutionOnly = true;
+            options.solutionOnly = true;
+            continue;
+        }
+        if(arg == "--stats")
+        {
+            if(!kSearchStatsEnabled)
+            {
+                std::cerr << "--stats needs a build with SUDOKU_SEARCH_STATS=ON\n";
+                return 1;
+            }
+            options.searchStats = true;
+            continue;
+        }
+        if(arg == "--serve")
+        {
+            options.serve = true;
+            continue;
+        }
+        if(arg == "--serve-socket" && i + 1 < argc)
+        {
+            options.serve = true;
+            options.socketPath = argv[++i];
+            continue;
+        }
+        if(arg == "--dedup")
+        {
+            options.dedup = true;
+            continue;
+        }
+        if(arg == "--lanes")
+        {
+            options.lanes = true;
+            continue;
+        }
+        if(arg == "--size" && i + 1 < argc)
+        {
+            unsigned int parsed = 0;
+            if(!parseUnsigned(argv[++i], parsed) || (parsed != 9 && parsed != 16 && parsed != 25))
+            {
+                std::cerr << "Invalid value for --size\n";
+                return 1;
+            }
+            options.size = parsed;
             continue;
         }
         if(arg == "--clues" && i + 1 < argc)
@@ -52,7 +783,18 @@ int main(int argc, const char * argv[]) {
                 std::cerr << "Invalid value for --clues\n";
                 return 1;
             }
-            clues = parsed;
+            options.clues = parsed;
+            continue;
+        }
+        if(arg == "--difficulty" && i + 1 < argc)
+        {
+            Difficulty parsed = Difficulty::Easy;
+            if(!parseDifficulty(argv[++i], parsed))
+            {
+                std::cerr << "Invalid value for --difficulty\n";
+                return 1;
+            }
+            options.difficulty = parsed;
             continue;
         }
         if(arg == "--seed" && i + 1 < argc)
@@ -63,7 +805,110 @@ int main(int argc, const char * argv[]) {
                 std::cerr << "Invalid value for --seed\n";
                 return 1;
             }
-            seed = parsed;
+            options.seed = parsed;
+            continue;
+        }
+        if(arg == "--count" && i + 1 < argc)
+        {
+            unsigned int parsed = 0;
+            if(!parseUnsigned(argv[++i], parsed))
+            {
+                std::cerr << "Invalid value for --count\n";
+                return 1;
+            }
+            options.count = parsed;
+            continue;
+        }
+        if(arg == "--solve" && i + 1 < argc)
+        {
+            options.solvePath = argv[++i];
+            continue;
+        }
+        if(arg == "--packed-out" && i + 1 < argc)
+        {
+            options.packedOutPath = argv[++i];
+            continue;
+        }
+        if(arg == "--grade" && i + 1 < argc)
+        {
+            options.gradePath = argv[++i];
+            continue;
+        }
+        if(arg == "--count-solutions" && i + 1 < argc)
+        {
+            options.countPath = argv[++i];
+            continue;
+        }
+        if(arg == "--limit" && i + 1 < argc)
+        {
+            uint64_t parsed = 0;
+            if(!parseUnsigned(argv[++i], parsed) || parsed == 0)
+            {
+                std::cerr << "Invalid value for --limit\n";
+                return 1;
+            }
+            options.limit = parsed;
+            continue;
+        }
+        if(arg == "--cache" && i + 1 < argc)
+        {
+            uint64_t parsed = 0;
+            if(!parseUnsigned(argv[++i], parsed) || parsed == 0)
+            {
+                std::cerr << "Invalid value for --cache\n";
+                return 1;
+            }
+            options.cacheSize = static_cast<std::size_t>(parsed);
+            continue;
+        }
+        if(arg == "--sample-pool" && i + 1 < argc)
+        {
+            if(!parseUnsigned(argv[++i], options.samplePool) || options.samplePool == 0
+               || options.samplePool > std::numeric_limits<uint32_t>::max())
+            {
+                std::cerr << "Invalid value for --sample-pool\n";
+                return 1;
+            }
+            continue;
+        }
+        if(arg == "--fresh-every" && i + 1 < argc)
+        {
+            if(!parseUnsigned(argv[++i], options.freshEvery) || options.freshEvery == 0)
+            {
+                std::cerr << "Invalid value for --fresh-every\n";
+                return 1;
+            }
+            continue;
+        }
+        if(arg == "--timeout-ms" && i + 1 < argc)
+        {
+            if(!parseUnsigned(argv[++i], options.timeoutMs) || options.timeoutMs == 0)
+            {
+                std::cerr << "Invalid value for --timeout-ms\n";
+                return 1;
+            }
+            continue;
+        }
+        if(arg == "--threads" && i + 1 < argc)
+        {
+            unsigned int parsed = 0;
+            if(!parseUnsigned(argv[++i], parsed) || parsed == 0)
+            {
+                std::cerr << "Invalid value for --threads\n";
+                return 1;
+            }
+            options.threads = parsed;
+            continue;
+        }
+
+        if(arg == "--backend" && i + 1 < argc)
+        {
+            if(!parseBackend(argv[++i], options.backend))
+            {
+                std::cerr << "Invalid value for --backend\n";
+                return 1;
+            }
+            options.backendSet = true;
             continue;
         }
 
@@ -72,30 +917,56 @@ int main(int argc, const char * argv[]) {
         return 1;
     }
 
-    std::unique_ptr<Board> board = std::make_unique<Board>(seed);
-
-    constexpr unsigned int maxAttempts = 1000;
-    bool success = false;
+    if(options.dedup && (!options.count.has_value() || options.size != 9))
+    {
+        std::cerr << "--dedup needs --count and a 9x9 board\n";
+        return 1;
+    }
 
-    for(unsigned int attempt = 0; attempt < maxAttempts; ++attempt)
+    if(options.serve)
     {
-        if(solutionOnly)
-        {
-            if(board->generateSolution()) { success = true; break; }
-        }
-        else
+        if(options.size != 9)
         {
-            if(board->generatePuzzle(clues)) { success = true; break; }
+            std::cerr << "--serve supports 9x9 boards only\n";
+            return 1;
         }
+        return runServer(options);
     }
 
-    if(!success)
+    if(options.timeoutMs != 0)
     {
-        std::cerr << "Failed to generate board after " << maxAttempts << " attempts\n";
+        std::cerr << "--timeout-ms needs --serve or --serve-socket\n";
         return 1;
     }
 
-    std::cout << *board;
+    if(options.lanes && (!options.solvePath.has_value() || options.size != 9 || options.searchStats || options.cacheSize != 0
+                         || options.backendSet))
+    {
+        std::cerr << "--lanes needs --solve, a 9x9 board, no --stats, no --cache and no --backend\n";
+        return 1;
+    }
 
-    return 0;
+    if(options.samplePool != 0 && (!options.count.has_value() || !options.solutionOnly || options.size != 9 || options.dedup))
+    {
+        std::cerr << "--sample-pool needs --count, --solution, a 9x9 board and no --dedup\n";
+        return 1;
+    }
+    if(options.freshEvery != 0 && options.samplePool == 0)
+    {
+        std::cerr << "--fresh-every needs --sample-pool\n";
+        return 1;
+    }
+
+    if(options.cacheSize != 0 && (!options.solvePath.has_value() || options.size != 9 || options.searchStats))
+    {
+        std::cerr << "--cache needs --solve or --serve, a 9x9 board and no --stats\n";
+        return 1;
+    }
+
+    switch(options.size)
+    {
+        case 16: return run<4>(options);
+        case 25: return run<5>(options);
+        default: return run<3>(options);
+    }
 }
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BatchSolver.h"
+#include "Board.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < BatchSolver::kCells; ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kHardSolution =
+    "417369825632158947958724316825437169791586432346912758289643571573291684164875293";
+// Seven solutions.
+const std::string kOpenPuzzle =
+    "..7..9.2.6.....94....724.1...54..1.9..1.8.....4.....5.2..6...71573.....4.6..7...3";
+
+} // namespace
+
+TEST(BatchSolverTest, laneVectorOperations)
+{
+    LaneVector::Lanes values{};
+    for(unsigned int lane = 0; lane < LaneVector::kLanes; ++lane)
+        values[lane] = static_cast<uint16_t>(lane * 37 % 512);
+    const LaneVector vector = LaneVector::load(values.data());
+
+    LaneVector::Lanes counts{};
+    vector.popcount().store(counts.data());
+    uint32_t single = 0;
+    for(unsigned int lane = 0; lane < LaneVector::kLanes; ++lane)
+    {
+        EXPECT_EQ(counts[lane], static_cast<uint16_t>(std::popcount(values[lane])));
+        single |= std::popcount(values[lane]) <= 1 ? 1u << lane : 0u;
+    }
+    EXPECT_EQ(vector.atMostOneBitLanes().laneBits(), single);
+    EXPECT_EQ(vector.zeroLanes().laneBits(), 1u);
+    EXPECT_EQ(equal(vector, vector).laneBits(), (1u << LaneVector::kLanes) - 1);
+    EXPECT_TRUE(less(vector, vector).isEmpty());
+}
+
+TEST(BatchSolverTest, solvesMoreBatchesThanLanesInPuzzleOrder)
+{
+    // Generated puzzles of mixed difficulty, so lanes finish at different
+    // times and are refilled out of step.
+    std::vector<Grid> puzzles;
+    std::vector<Grid> solutions;
+    Board board(5);
+    for(unsigned int index = 0; index < 5 * BatchSolver::kLanes; ++index)
+    {
+        ASSERT_TRUE(board.generatePuzzle(index % 2 == 0 ? 24 : 40));
+        puzzles.push_back(board.getBoardData());
+        ASSERT_TRUE(board.solve());
+        solutions.push_back(board.getBoardData());
+    }
+    puzzles.push_back(cellsFromString(kHardPuzzle));
+    solutions.push_back(cellsFromString(kHardSolution));
+
+    BatchSolver solver;
+    std::vector<BatchOutcome> outcomes(puzzles.size());
+    solver.solve(puzzles, outcomes, 2);
+    for(std::size_t index = 0; index < puzzles.size(); ++index)
+    {
+        EXPECT_EQ(outcomes[index].solutions, 1u) << index;
+        EXPECT_EQ(outcomes[index].solution, solutions[index]) << index;
+    }
+    EXPECT_GE(solver.nodes(), puzzles.size());
+}
+
+TEST(BatchSolverTest, reportsUnsolvableInvalidAndAmbiguousPuzzles)
+{
+    std::string conflicting = kHardPuzzle;
+    conflicting[1] = '4';
+    Grid invalid = cellsFromString(kHardPuzzle);
+    invalid[5] = 12;
+    // No digit is left for the first cell, although no two givens clash.
+    const Grid deadCell = cellsFromString(".23456789.1" + std::string(70, '.'));
+
+    const std::vector<Grid> puzzles = {
+        cellsFromString(conflicting), invalid, deadCell, cellsFromString(kOpenPuzzle), cellsFromString(kHardPuzzle),
+    };
+    std::vector<BatchOutcome> outcomes(puzzles.size());
+
+    BatchSolver solver;
+    solver.solve(puzzles, outcomes, 100);
+    EXPECT_EQ(outcomes[0].solutions, 0u);
+    EXPECT_EQ(outcomes[1].solutions, 0u);
+    EXPECT_EQ(outcomes[2].solutions, 0u);
+    EXPECT_EQ(outcomes[3].solutions, 7u);
+    EXPECT_EQ(outcomes[4].solutions, 1u);
+    EXPECT_EQ(outcomes[0].solution, Grid{});
+
+    // A complete grid that a board accepts has no conflicts.
+    Board board;
+    EXPECT_TRUE(board.loadFromData(outcomes[3].solution));
+    EXPECT_EQ(std::count(outcomes[3].solution.begin(), outcomes[3].solution.end(), 0), 0);
+
+    solver.solve(puzzles, outcomes, 2);
+    EXPECT_EQ(outcomes[3].solutions, 2u);
+    EXPECT_EQ(outcomes[4].solution, cellsFromString(kHardSolution));
+}
+
+TEST(BatchSolverTest, emptyGridHasSolutions)
+{
+    const std::vector<Grid> puzzles(3, Grid{});
+    std::vector<BatchOutcome> outcomes(puzzles.size());
+    BatchSolver solver;
+    solver.solve(puzzles, outcomes, 50);
+    for(const BatchOutcome& outcome : outcomes)
+        EXPECT_EQ(outcome.solutions, 50u);
+
+    solver.solve({}, {}, 1);
+    EXPECT_EQ(solver.nodes(), 0u);
+}
@@ -0,0 +1,175 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BitboardSolver.h"
+#include "Board.h"
+#include "Solver.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < BitboardSolver::kCells; ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kHardSolution =
+    "417369825632158947958724316825437169791586432346912758289643571573291684164875293";
+
+} // namespace
+
+TEST(BitboardSolverTest, solveFindsTheUniqueSolution)
+{
+    BitboardSolver solver;
+    ASSERT_TRUE(solver.load(cellsFromString(kHardPuzzle)));
+    ASSERT_TRUE(solver.solve());
+
+    Grid solved{};
+    solver.store(solved);
+    EXPECT_EQ(solved, cellsFromString(kHardSolution));
+    EXPECT_GT(solver.nodes(), 0u);
+}
+
+TEST(BitboardSolverTest, countMatchesMrvSolver)
+{
+    std::string puzzle = kHardSolution;
+    for(unsigned int index : {0u, 1u, 9u, 10u, 30u, 31u, 40u, 50u, 60u, 70u, 4u, 13u, 27u, 36u})
+        puzzle[index] = '.';
+
+    BitboardSolver dlx;
+    Solver mrv;
+    for(const std::string& text : {puzzle, kHardPuzzle, std::string(81, '.')})
+    {
+        const Grid cells = cellsFromString(text);
+        ASSERT_TRUE(dlx.load(cells));
+        ASSERT_TRUE(mrv.load(cells));
+        EXPECT_EQ(dlx.count(50), mrv.count(50));
+    }
+}
+
+TEST(BitboardSolverTest, solverCanBeReloadedAfterSolve)
+{
+    BitboardSolver solver;
+    const Grid cells = cellsFromString(kHardPuzzle);
+
+    ASSERT_TRUE(solver.load(cells));
+    ASSERT_TRUE(solver.solve());
+    ASSERT_TRUE(solver.load(cells));
+    EXPECT_EQ(solver.count(2), 1u);
+    EXPECT_EQ(solver.count(2), 1u);
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, cells);
+
+    ASSERT_TRUE(solver.load(Grid{}));
+    Pcg32 rng(5);
+    ASSERT_TRUE(solver.solve(&rng));
+    Grid solved{};
+    solver.store(solved);
+    Solver check;
+    ASSERT_TRUE(check.load(solved));
+    EXPECT_EQ(check.count(2), 1u);
+}
+
+TEST(BitboardSolverTest, loadRejectsConflictingGivensAndRecovers)
+{
+    BitboardSolver solver;
+    Grid cells{};
+    cells[0] = 3;
+    cells[8] = 3;
+    EXPECT_FALSE(solver.load(cells));
+    EXPECT_FALSE(solver.solve());
+    EXPECT_EQ(solver.count(2), 0u);
+
+    ASSERT_TRUE(solver.load(cellsFromString(kHardPuzzle)));
+    EXPECT_EQ(solver.count(2), 1u);
+}
+
+TEST(BitboardSolverTest, emptyCandidateCellMakesPuzzleUnsolvable)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < 8; ++index)
+        cells[index] = static_cast<uint8_t>(index + 1);
+    cells[8 + 9 * 4] = 9;
+
+    BitboardSolver solver;
+    ASSERT_TRUE(solver.load(cells));
+    EXPECT_FALSE(solver.solve());
+    EXPECT_EQ(solver.count(2), 0u);
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, cells);
+}
+
+TEST(BitboardSolverTest, bitboardLanesFollowBands)
+{
+    Bitboard board = Bitboard::load({1u, 1u << 26, 1u << 9, 0u});
+    std::vector<unsigned int> cells;
+    board.forEachCell([&](unsigned int cell) { cells.push_back(cell); });
+    EXPECT_EQ(cells, (std::vector<unsigned int>{0u, 53u, 63u}));
+    EXPECT_EQ(board.firstCell(), 0u);
+
+    EXPECT_EQ(board.rotateBands().lanes(), (BitboardLanes{1u << 26, 1u << 9, 1u, 0u}));
+    EXPECT_EQ(board.rotateBandsTwice().lanes(), (BitboardLanes{1u << 9, 1u, 1u << 26, 0u}));
+    EXPECT_EQ(Bitboard::load({0u, 3u, 0u, 0u}).emptyBands(), 5u);
+    EXPECT_EQ(Bitboard::load({0u, 3u, 4u, 0u}).atMostOneBitLanes().lanes(), (BitboardLanes{~0u, 0u, ~0u, ~0u}));
+    EXPECT_TRUE(andNot(board, board).isEmpty());
+}
+
+TEST(BitboardSolverTest, agreesWithMrvOnGeneratedPuzzles)
+{
+    Board generator(21);
+    BitboardSolver bitboard;
+    Solver mrv;
+    for(unsigned int round = 0; round < 20; ++round)
+    {
+        ASSERT_TRUE(generator.generateSolution());
+        Grid cells = generator.getBoardData();
+        for(unsigned int index = round % 3; index < Grid().size(); index += 2 + round % 3)
+            cells[index] = 0;
+
+        ASSERT_TRUE(bitboard.load(cells));
+        ASSERT_TRUE(mrv.load(cells));
+        EXPECT_EQ(bitboard.count(20), mrv.count(20));
+        ASSERT_TRUE(bitboard.solve());
+
+        Grid solved{};
+        bitboard.store(solved);
+        ASSERT_TRUE(mrv.load(solved));
+        EXPECT_EQ(mrv.count(2), 1u);
+        for(unsigned int index = 0; index < solved.size(); ++index)
+        {
+            if(cells[index] != 0)
+            {
+                EXPECT_EQ(solved[index], cells[index]);
+            }
+        }
+    }
+}
+
+TEST(BitboardSolverTest, hasSolutionExcludingMatchesMrvSolver)
+{
+    const Grid solution = cellsFromString(kHardSolution);
+    BitboardSolver bitboard;
+    Solver mrv;
+    for(unsigned int cell : {1u, 2u, 3u, 20u, 44u})
+    {
+        Grid puzzle = cellsFromString(kHardPuzzle);
+        for(unsigned int index = 0; index < puzzle.size(); index += 7)
+            puzzle[index] = 0;
+        puzzle[cell] = 0;
+        ASSERT_TRUE(bitboard.load(puzzle));
+        ASSERT_TRUE(mrv.load(puzzle));
+        EXPECT_EQ(bitboard.hasSolutionExcluding(cell, solution[cell]), mrv.hasSolutionExcluding(cell, solution[cell]));
+        EXPECT_EQ(bitboard.count(2), mrv.count(2));
+    }
+}
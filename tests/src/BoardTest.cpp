@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <array>
 #include <sstream>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -13,7 +15,8 @@ namespace {
 std::array<unsigned int, 9> sortedRow(const Board& board, unsigned int index)
 {
     std::array<unsigned int, 9> row{};
-    std::vector<unsigned int> values = board.getRow(index);
+    const UnitView view = board.getRow(index);
+    std::vector<unsigned int> values(view.begin(), view.end());
     std::sort(values.begin(), values.end());
     std::copy(values.begin(), values.end(), row.begin());
     return row;
@@ -22,7 +25,8 @@ std::array<unsigned int, 9> sortedRow(const Board& board, unsigned int index)
 std::array<unsigned int, 9> sortedColumn(const Board& board, unsigned int index)
 {
     std::array<unsigned int, 9> column{};
-    std::vector<unsigned int> values = board.getColumn(index);
+    const UnitView view = board.getColumn(index);
+    std::vector<unsigned int> values(view.begin(), view.end());
     std::sort(values.begin(), values.end());
     std::copy(values.begin(), values.end(), column.begin());
     return column;
@@ -31,7 +35,8 @@ std::array<unsigned int, 9> sortedColumn(const Board& board, unsigned int index)
 std::array<unsigned int, 9> sortedQuadrant(const Board& board, unsigned int index)
 {
     std::array<unsigned int, 9> quadrant{};
-    std::vector<unsigned int> values = board.getQuadrant(index);
+    const UnitView view = board.getQuadrant(index);
+    std::vector<unsigned int> values(view.begin(), view.end());
     std::sort(values.begin(), values.end());
     std::copy(values.begin(), values.end(), quadrant.begin());
     return quadrant;
@@ -64,7 +69,7 @@ TEST(BoardTest, generatePuzzleProducesUniqueBoardWithClueCount)
     const unsigned int clueTarget = 30;
     EXPECT_TRUE(board.generatePuzzle(clueTarget));
 
-    const std::vector<unsigned int>& data = board.getBoardData();
+    const Grid& data = board.getBoardData();
     unsigned int clues = 0;
     for(auto cell : data)
     {
@@ -170,6 +175,29 @@ TEST(BoardTest, differentSeedsProduceDifferentSolutions)
     EXPECT_NE(board1.getBoardData(), board2.getBoardData());
 }
 
+TEST(BoardTest, randomEngineIsAPolicyParameter)
+{
+    BasicBoard<3, Pcg32> pcg(1234);
+    ASSERT_TRUE(pcg.generatePuzzle(26));
+    BasicBoard<3, Pcg32> pcgAgain(1234);
+    ASSERT_TRUE(pcgAgain.generatePuzzle(26));
+    EXPECT_EQ(pcg.getBoardData(), pcgAgain.getBoardData());
+
+    Board xoshiro(1234);
+    ASSERT_TRUE(xoshiro.generatePuzzle(26));
+    EXPECT_NE(pcg.getBoardData(), xoshiro.getBoardData());
+    EXPECT_EQ(pcg.countSolutions(2), 1u);
+
+    for(SolverBackend backend : {SolverBackend::Mrv, SolverBackend::Dlx, SolverBackend::Bitboard})
+    {
+        BasicBoard<3, Pcg32> first(9);
+        BasicBoard<3, Pcg32> second(9);
+        ASSERT_TRUE(first.generateSolution(backend));
+        ASSERT_TRUE(second.generateSolution(backend));
+        EXPECT_EQ(first.getBoardData(), second.getBoardData());
+    }
+}
+
 TEST(BoardTest, countSolutionsReturnsZeroWhenLimitIsZero)
 {
     Board board(1212);
@@ -211,9 +239,9 @@ TEST(BoardTest, generatePuzzleWithFullCluesKeepsSolvedBoard)
 TEST(BoardTest, getRowColumnAndQuadrantReadExpectedCells)
 {
     Board board;
-    std::vector<unsigned int>& data = board.getBoardData();
+    Grid& data = board.getBoardData();
     for(unsigned int i = 0; i < data.size(); ++i)
-        data[i] = i + 1;
+        data[i] = static_cast<uint8_t>(i + 1);
 
     EXPECT_EQ(board.getRow(2)[0], 19u);
     EXPECT_EQ(board.getRow(2)[8], 27u);
@@ -229,3 +257,270 @@ TEST(BoardTest, isVectorUniqueReturnsFalseWhenValueExceedsBoardDimension)
     std::vector<unsigned int> invalid = {1, 2, 3, 4, 5, 6, 7, 8, 10};
     EXPECT_FALSE(board.isVectorUnique(invalid));
 }
+
+TEST(BoardTest, loadFromStringRoundTripsThroughToString)
+{
+    const std::string puzzle =
+        "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+    Board board;
+    ASSERT_TRUE(board.loadFromString(puzzle));
+    EXPECT_EQ(board.getBoardData()[0], 5u);
+    EXPECT_EQ(board.getBoardData()[2], 0u);
+    EXPECT_EQ(board.toString(), puzzle);
+}
+
+TEST(BoardTest, loadFromStringRejectsMalformedInput)
+{
+    Board board;
+    EXPECT_FALSE(board.loadFromString("123"));
+    EXPECT_FALSE(board.loadFromString(std::string(80, '.') + "x"));
+}
+
+TEST(BoardTest, solveFillsPuzzleWithItsUniqueSolution)
+{
+    Board board;
+    ASSERT_TRUE(board.loadFromString(
+        "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79"));
+    ASSERT_TRUE(board.solve());
+    EXPECT_EQ(board.toString(),
+              "534678912672195348198342567859761423426853791713924856961537284287419635345286179");
+}
+
+TEST(BoardTest, solveFailsForUnsolvablePuzzle)
+{
+    Board board;
+    ASSERT_TRUE(board.loadFromString("11" + std::string(79, '.')));
+    EXPECT_FALSE(board.solve());
+}
+
+TEST(BoardTest, propagationKeepsCountsAndReducesSearchNodes)
+{
+    const std::string puzzle =
+        "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+    Board board;
+    ASSERT_TRUE(board.loadFromString(puzzle));
+
+    board.setPropagationEnabled(false);
+    EXPECT_EQ(board.countSolutions(2), 1u);
+    const uint64_t plainNodes = board.getLastSearchNodes();
+
+    board.setPropagationEnabled(true);
+    EXPECT_EQ(board.countSolutions(2), 1u);
+    EXPECT_LT(board.getLastSearchNodes(), plainNodes);
+    EXPECT_EQ(board.toString(), puzzle);
+}
+
+TEST(BoardTest, countSolutionsFindsMultipleSolutionsWithPropagation)
+{
+    Board board;
+    ASSERT_TRUE(board.loadFromString(std::string(81, '.')));
+    EXPECT_EQ(board.countSolutions(5), 5u);
+    EXPECT_EQ(board.toString(), std::string(81, '.'));
+}
+
+TEST(BoardTest, gridIsCompactAndTriviallyCopyable)
+{
+    static_assert(sizeof(Grid) == Board::BOARD_DIMENSION * Board::BOARD_DIMENSION);
+    static_assert(std::is_trivially_copyable_v<Grid>);
+
+    Board board(77);
+    ASSERT_TRUE(board.generateSolution());
+    const Grid snapshot = board.getBoardData();
+    board.getBoardData().fill(0);
+    EXPECT_NE(board.getBoardData(), snapshot);
+    board.getBoardData() = snapshot;
+    EXPECT_EQ(board.getBoardData(), snapshot);
+}
+
+TEST(BoardTest, isUnitUniqueValidatesViewsWithoutCopying)
+{
+    Board board(31);
+    ASSERT_TRUE(board.generateSolution());
+    for(unsigned int index = 0; index < Board::BOARD_DIMENSION; ++index)
+    {
+        EXPECT_TRUE(board.isUnitUnique(board.getRow(index)));
+        EXPECT_TRUE(board.isUnitUnique(board.getColumn(index)));
+        EXPECT_TRUE(board.isUnitUnique(board.getQuadrant(index)));
+    }
+
+    Grid& data = board.getBoardData();
+    data[1] = data[0];
+    EXPECT_FALSE(board.isUnitUnique(board.getRow(0)));
+    EXPECT_FALSE(board.isUnitUnique(board.getQuadrant(0)));
+    EXPECT_TRUE(board.isUnitUnique(board.getColumn(0)));
+}
+
+TEST(BoardTest, unitViewsThrowForOutOfRangeIndex)
+{
+    Board board;
+    EXPECT_THROW(board.getRow(9), std::out_of_range);
+    EXPECT_THROW(board.getColumn(9), std::out_of_range);
+    EXPECT_THROW(board.getQuadrant(9), std::out_of_range);
+}
+
+template <unsigned int Box>
+void expectValidSolution(const BasicBoard<Box>& board)
+{
+    for(unsigned int index = 0; index < BasicBoard<Box>::BOARD_DIMENSION; ++index)
+    {
+        EXPECT_TRUE(board.isUnitUnique(board.getRow(index)));
+        EXPECT_TRUE(board.isUnitUnique(board.getColumn(index)));
+        EXPECT_TRUE(board.isUnitUnique(board.getQuadrant(index)));
+    }
+    for(uint8_t value : board.getBoardData())
+        EXPECT_NE(value, 0u);
+}
+
+TEST(BoardTest, generatesLargerBoards)
+{
+    BasicBoard<4> board16(16);
+    ASSERT_TRUE(board16.generateSolution());
+    expectValidSolution(board16);
+
+    BasicBoard<5> board25(25);
+    ASSERT_TRUE(board25.generateSolution());
+    expectValidSolution(board25);
+}
+
+TEST(BoardTest, generatesUniqueSixteenBySixteenPuzzle)
+{
+    BasicBoard<4> board(7);
+    ASSERT_TRUE(board.generatePuzzle(140));
+
+    unsigned int clues = 0;
+    for(uint8_t value : board.getBoardData())
+        clues += value != 0 ? 1 : 0;
+    EXPECT_EQ(clues, 140u);
+    EXPECT_EQ(board.countSolutions(2), 1u);
+
+    ASSERT_TRUE(board.solve());
+    expectValidSolution(board);
+}
+
+TEST(BoardTest, largerBoardsRoundTripLetterDigits)
+{
+    BasicBoard<4> board(3);
+    ASSERT_TRUE(board.generateSolution());
+    const std::string text = board.toString();
+    EXPECT_EQ(text.size(), 256u);
+    EXPECT_NE(text.find('G'), std::string::npos);
+
+    BasicBoard<4> copy;
+    ASSERT_TRUE(copy.loadFromString(text));
+    EXPECT_EQ(copy.getBoardData(), board.getBoardData());
+
+    std::string tooLarge = text;
+    tooLarge[0] = 'H';
+    EXPECT_FALSE(copy.loadFromString(tooLarge));
+}
+
+TEST(BoardTest, backendsAgreeOnSolveAndCount)
+{
+    const std::string puzzle = "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+    Board mrv;
+    Board dlx;
+    ASSERT_TRUE(mrv.loadFromString(puzzle));
+    ASSERT_TRUE(dlx.loadFromString(puzzle));
+    EXPECT_EQ(dlx.countSolutions(2, SolverBackend::Dlx), 1u);
+    ASSERT_TRUE(mrv.solve(SolverBackend::Mrv));
+    ASSERT_TRUE(dlx.solve(SolverBackend::Dlx));
+    EXPECT_EQ(dlx.getBoardData(), mrv.getBoardData());
+
+    ASSERT_TRUE(dlx.loadFromString(std::string(81, '.')));
+    EXPECT_EQ(dlx.countSolutions(7, SolverBackend::Dlx), 7u);
+}
+
+TEST(BoardTest, dlxBackendGeneratesValidSolutionsAndPuzzles)
+{
+    Board board(12);
+    ASSERT_TRUE(board.generateSolution(SolverBackend::Dlx));
+    expectValidSolution(board);
+
+    ASSERT_TRUE(board.generatePuzzle(28, SolverBackend::Dlx));
+    EXPECT_EQ(board.countSolutions(2, SolverBackend::Mrv), 1u);
+    EXPECT_EQ(board.countSolutions(2, SolverBackend::Dlx), 1u);
+    EXPECT_GT(board.getLastSearchNodes(), 0u);
+
+    BasicBoard<4> large(4);
+    ASSERT_TRUE(large.generateSolution(SolverBackend::Dlx));
+    expectValidSolution(large);
+}
+
+TEST(BoardTest, bitboardBackendMatchesOtherBackends)
+{
+    const std::string puzzle = "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+    Board board;
+    ASSERT_TRUE(board.loadFromString(puzzle));
+    EXPECT_EQ(board.countSolutions(2, SolverBackend::Bitboard), 1u);
+    ASSERT_TRUE(board.solve(SolverBackend::Bitboard));
+    EXPECT_EQ(board.toString(), "417369825632158947958724316825437169791586432346912758289643571573291684164875293");
+
+    ASSERT_TRUE(board.generatePuzzle(26, SolverBackend::Bitboard));
+    EXPECT_EQ(board.countSolutions(2, SolverBackend::Mrv), 1u);
+
+    // Larger boards fall back to the MRV solver.
+    BasicBoard<4> large(9);
+    ASSERT_TRUE(large.generateSolution(SolverBackend::Bitboard));
+    expectValidSolution(large);
+}
+
+TEST(BoardTest, lowClueGenerationRepairsInsteadOfRestarting)
+{
+    Board board(2022);
+    unsigned int repairSteps = 0;
+    for(unsigned int puzzle = 0; puzzle < 5; ++puzzle)
+    {
+        ASSERT_TRUE(board.generatePuzzle(22));
+        const GenerationStats& stats = board.getLastGenerationStats();
+        EXPECT_GE(stats.uniquenessChecks, 59u);
+        repairSteps += stats.repairSteps;
+
+        const Grid& data = board.getBoardData();
+        EXPECT_EQ(std::count_if(data.begin(), data.end(), [](uint8_t cell) { return cell != 0; }), 22);
+        EXPECT_EQ(board.countSolutions(2), 1u);
+    }
+    EXPECT_GT(repairSteps, 0u);
+
+    ASSERT_TRUE(board.generatePuzzle(23, SolverBackend::Dlx));
+    EXPECT_EQ(board.countSolutions(2), 1u);
+}
+
+TEST(BoardTest, tierGenerationRunsNoRepairSteps)
+{
+    // A tier names no clue count, so a stalled pass has nothing to repair
+    // towards; Extreme is the tier that removes clues by search.
+    Board board(2022);
+    for(Difficulty target : {Difficulty::Easy, Difficulty::Extreme})
+    {
+        board.generatePuzzle(target);
+        EXPECT_EQ(board.getLastGenerationStats().repairSteps, 0u);
+    }
+}
+
+TEST(BoardTest, forEachSolutionAgreesAcrossBackends)
+{
+    Board board(3);
+    const std::string puzzle = "..7..9.2.6.....94....724.1...54..1.9..1.8.....4.....5.2..6...71573.....4.6..7...3";
+    ASSERT_TRUE(board.loadFromString(puzzle));
+    const uint64_t expected = board.countSolutions(1000);
+    ASSERT_EQ(expected, 7u);
+
+    for(SolverBackend backend : {SolverBackend::Mrv, SolverBackend::Dlx, SolverBackend::Bitboard})
+    {
+        std::vector<std::string> solutions;
+        const uint64_t visited = board.forEachSolution([&](const Grid& solution) {
+            Board copy;
+            copy.loadFromData(solution);
+            solutions.push_back(copy.toString());
+            return true;
+        }, backend);
+        EXPECT_EQ(visited, expected);
+        std::sort(solutions.begin(), solutions.end());
+        EXPECT_EQ(std::unique(solutions.begin(), solutions.end()), solutions.end());
+        EXPECT_EQ(solutions.size(), expected);
+    }
+    EXPECT_EQ(board.toString(), puzzle);
+
+    unsigned int calls = 0;
+    EXPECT_EQ(board.forEachSolution([&](const Grid&) { return ++calls < 1; }, SolverBackend::Bitboard), 1u);
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "Board.h"
+#include "Canonical.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < cells.size(); ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kEasyPuzzle =
+    "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+
+// A random element of the symmetry group.
+GridTransform randomTransform(std::mt19937& rng)
+{
+    GridTransform transform;
+    transform.transpose = (rng() & 1) != 0;
+
+    auto shuffleWithinGroups = [&](std::array<uint8_t, 9>& order) {
+        std::array<uint8_t, 3> groups{0, 1, 2};
+        std::shuffle(groups.begin(), groups.end(), rng);
+        for(unsigned int group = 0; group < 3; ++group)
+        {
+            std::array<uint8_t, 3> inner{0, 1, 2};
+            std::shuffle(inner.begin(), inner.end(), rng);
+            for(unsigned int position = 0; position < 3; ++position)
+                order[group * 3 + position] = static_cast<uint8_t>(groups[group] * 3 + inner[position]);
+        }
+    };
+    shuffleWithinGroups(transform.rows);
+    shuffleWithinGroups(transform.columns);
+    std::shuffle(transform.digits.begin() + 1, transform.digits.end(), rng);
+    return transform;
+}
+
+} // namespace
+
+TEST(CanonicalTest, untransformInvertsTransform)
+{
+    std::mt19937 rng(3);
+    const Grid puzzle = cellsFromString(kHardPuzzle);
+    for(unsigned int trial = 0; trial < 20; ++trial)
+    {
+        const GridTransform transform = randomTransform(rng);
+        EXPECT_EQ(untransformGrid(transform, transformGrid(transform, puzzle)), puzzle);
+    }
+}
+
+TEST(CanonicalTest, equivalentPuzzlesShareTheCanonicalGrid)
+{
+    std::mt19937 rng(11);
+    for(const std::string& text : {kHardPuzzle, kEasyPuzzle})
+    {
+        const Grid puzzle = cellsFromString(text);
+        const CanonicalForm form = canonicalize(puzzle);
+        EXPECT_EQ(transformGrid(form.transform, puzzle), form.grid);
+        EXPECT_EQ(canonicalize(form.grid).grid, form.grid);
+
+        for(unsigned int trial = 0; trial < 10; ++trial)
+            EXPECT_EQ(canonicalize(transformGrid(randomTransform(rng), puzzle)).grid, form.grid);
+    }
+}
+
+TEST(CanonicalTest, canonicalSolutionMapsBackToTheOriginal)
+{
+    Board board(4);
+    ASSERT_TRUE(board.loadFromString(kHardPuzzle));
+    const CanonicalForm form = canonicalize(board.getBoardData());
+
+    Board canonical;
+    ASSERT_TRUE(canonical.loadFromData(form.grid));
+    ASSERT_TRUE(canonical.solve());
+    ASSERT_TRUE(board.solve());
+    EXPECT_EQ(untransformGrid(form.transform, canonical.getBoardData()), board.getBoardData());
+}
+
+TEST(CanonicalTest, dedupIndexDropsEquivalentPuzzles)
+{
+    std::mt19937 rng(5);
+    DedupIndex index;
+    EXPECT_TRUE(index.insert(cellsFromString(kHardPuzzle)));
+    EXPECT_TRUE(index.insert(cellsFromString(kEasyPuzzle)));
+    EXPECT_FALSE(index.insert(transformGrid(randomTransform(rng), cellsFromString(kHardPuzzle))));
+    EXPECT_FALSE(index.insert(transformGrid(randomTransform(rng), cellsFromString(kEasyPuzzle))));
+    EXPECT_EQ(index.size(), 2u);
+
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+}
@@ -0,0 +1,128 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "DlxSolver.h"
+#include "Solver.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < DlxSolver::kCells; ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kHardSolution =
+    "417369825632158947958724316825437169791586432346912758289643571573291684164875293";
+
+} // namespace
+
+TEST(DlxSolverTest, solveFindsTheUniqueSolution)
+{
+    DlxSolver solver;
+    ASSERT_TRUE(solver.load(cellsFromString(kHardPuzzle)));
+    ASSERT_TRUE(solver.solve());
+
+    Grid solved{};
+    solver.store(solved);
+    EXPECT_EQ(solved, cellsFromString(kHardSolution));
+    EXPECT_GT(solver.nodes(), 0u);
+}
+
+TEST(DlxSolverTest, countMatchesMrvSolver)
+{
+    std::string puzzle = kHardSolution;
+    for(unsigned int index : {0u, 1u, 9u, 10u, 30u, 31u, 40u, 50u, 60u, 70u, 4u, 13u, 27u, 36u})
+        puzzle[index] = '.';
+
+    DlxSolver dlx;
+    Solver mrv;
+    for(const std::string& text : {puzzle, kHardPuzzle, std::string(81, '.')})
+    {
+        const Grid cells = cellsFromString(text);
+        ASSERT_TRUE(dlx.load(cells));
+        ASSERT_TRUE(mrv.load(cells));
+        EXPECT_EQ(dlx.count(50), mrv.count(50));
+    }
+}
+
+TEST(DlxSolverTest, matrixIsReusedAcrossLoads)
+{
+    DlxSolver solver;
+    const Grid cells = cellsFromString(kHardPuzzle);
+
+    // A successful solve leaves the solution selected; the next load releases it.
+    ASSERT_TRUE(solver.load(cells));
+    ASSERT_TRUE(solver.solve());
+    ASSERT_TRUE(solver.load(cells));
+    EXPECT_EQ(solver.count(2), 1u);
+    EXPECT_EQ(solver.count(2), 1u);
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, cells);
+
+    ASSERT_TRUE(solver.load(Grid{}));
+    Pcg32 rng(5);
+    ASSERT_TRUE(solver.solve(&rng));
+    Grid solved{};
+    solver.store(solved);
+    Solver check;
+    ASSERT_TRUE(check.load(solved));
+    EXPECT_EQ(check.count(2), 1u);
+}
+
+TEST(DlxSolverTest, loadRejectsConflictingGivensAndRecovers)
+{
+    DlxSolver solver;
+    Grid cells{};
+    cells[0] = 3;
+    cells[8] = 3;
+    EXPECT_FALSE(solver.load(cells));
+    EXPECT_FALSE(solver.solve());
+    EXPECT_EQ(solver.count(2), 0u);
+
+    ASSERT_TRUE(solver.load(cellsFromString(kHardPuzzle)));
+    EXPECT_EQ(solver.count(2), 1u);
+}
+
+TEST(DlxSolverTest, emptyCandidateCellMakesPuzzleUnsolvable)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < 8; ++index)
+        cells[index] = static_cast<uint8_t>(index + 1);
+    cells[8 + 9 * 4] = 9;
+
+    DlxSolver solver;
+    ASSERT_TRUE(solver.load(cells));
+    EXPECT_FALSE(solver.solve());
+    EXPECT_EQ(solver.count(2), 0u);
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, cells);
+}
+
+TEST(DlxSolverTest, hasSolutionExcludingMatchesMrvSolver)
+{
+    const Grid solution = cellsFromString(kHardSolution);
+    DlxSolver dlx;
+    Solver mrv;
+    for(unsigned int cell : {1u, 2u, 3u, 20u, 44u})
+    {
+        Grid puzzle = cellsFromString(kHardPuzzle);
+        for(unsigned int index = 0; index < puzzle.size(); index += 7)
+            puzzle[index] = 0;
+        puzzle[cell] = 0;
+        ASSERT_TRUE(dlx.load(puzzle));
+        ASSERT_TRUE(mrv.load(puzzle));
+        EXPECT_EQ(dlx.hasSolutionExcluding(cell, solution[cell]), mrv.hasSolutionExcluding(cell, solution[cell]));
+        EXPECT_EQ(dlx.count(2), mrv.count(2));
+    }
+}
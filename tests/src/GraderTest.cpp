@@ -0,0 +1,91 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "Board.h"
+#include "Grader.h"
+#include "Solver.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < Grader::kCells; ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kEasyPuzzle =
+    "..3.2.6..9..3.5..1..18.64....81.29..7.......8..67.82....26.95..8..2.3..9..5.1.3..";
+// Stalls on singles, locked candidates, pairs and X-wings alike.
+const std::string kHardPuzzle =
+    "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..";
+
+} // namespace
+
+TEST(GraderTest, singlesSolveEasyPuzzle)
+{
+    const Grid cells = cellsFromString(kEasyPuzzle);
+    Grader grader;
+    EXPECT_EQ(grader.grade(cells), Difficulty::Easy);
+    ASSERT_TRUE(grader.solved());
+    EXPECT_GT(grader.uses(Technique::NakedSingle) + grader.uses(Technique::HiddenSingle), 0u);
+    EXPECT_EQ(grader.uses(Technique::XWing), 0u);
+
+    Solver solver;
+    ASSERT_TRUE(solver.load(cells));
+    ASSERT_TRUE(solver.solve());
+    Grid expected{};
+    Grid graded{};
+    solver.store(expected);
+    grader.store(graded);
+    EXPECT_EQ(graded, expected);
+}
+
+TEST(GraderTest, ceilingStopsEarly)
+{
+    const Grid cells = cellsFromString(kHardPuzzle);
+    Grader grader;
+    EXPECT_EQ(grader.grade(cells), Difficulty::Extreme);
+    EXPECT_FALSE(grader.solved());
+
+    EXPECT_EQ(grader.grade(cells, Difficulty::Easy), Difficulty::Medium);
+    EXPECT_FALSE(grader.solved());
+    EXPECT_EQ(grader.uses(Technique::LockedCandidates), 0u);
+}
+
+TEST(GraderTest, invalidGridRatesExtreme)
+{
+    Grid cells = cellsFromString(kEasyPuzzle);
+    cells[0] = 3;
+
+    Grader grader;
+    EXPECT_EQ(grader.grade(cells), Difficulty::Extreme);
+    EXPECT_FALSE(grader.solved());
+}
+
+TEST(GraderTest, generatesEveryTier)
+{
+    Board board(17);
+    for(Difficulty target : {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard, Difficulty::Expert, Difficulty::Extreme})
+    {
+        bool generated = false;
+        for(unsigned int attempt = 0; attempt < 500 && !generated; ++attempt)
+            generated = board.generatePuzzle(target);
+        ASSERT_TRUE(generated) << difficultyName(target);
+        EXPECT_EQ(board.grade(), target);
+        EXPECT_EQ(board.countSolutions(), 1u);
+    }
+}
+
+TEST(GraderTest, gradesLargerBoards)
+{
+    BasicBoard<4> board(3);
+    ASSERT_TRUE(board.generatePuzzle(Difficulty::Easy));
+
+    BasicGrader<4> grader;
+    EXPECT_EQ(grader.grade(board.getBoardData()), Difficulty::Easy);
+    EXPECT_TRUE(grader.solved());
+}
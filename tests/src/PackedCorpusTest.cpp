@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Board.h"
+#include "PackedCorpus.h"
+
+using namespace sudoku;
+
+namespace {
+
+std::string tempPath(const std::string& name)
+{
+    return ::testing::TempDir() + name;
+}
+
+template <unsigned int Box>
+std::vector<BasicGrid<Box>> makePuzzles(unsigned int count, unsigned int clues)
+{
+    BasicBoard<Box> board(31);
+    std::vector<BasicGrid<Box>> puzzles;
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        EXPECT_TRUE(board.generatePuzzle(clues));
+        puzzles.push_back(board.getBoardData());
+    }
+    return puzzles;
+}
+
+template <unsigned int Box>
+void expectRoundTrip(const std::vector<BasicGrid<Box>>& puzzles, const std::string& path)
+{
+    PackedWriter writer;
+    ASSERT_TRUE(writer.open(path, Geometry<Box>::kDimension));
+    for(const BasicGrid<Box>& puzzle : puzzles)
+        ASSERT_TRUE(writer.write<Box>(puzzle));
+    ASSERT_TRUE(writer.close());
+
+    ASSERT_TRUE(PackedReader::isPackedFile(path));
+    PackedReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.dimension(), Geometry<Box>::kDimension);
+    ASSERT_EQ(reader.size(), puzzles.size());
+    for(std::size_t i = 0; i < puzzles.size(); ++i)
+    {
+        BasicGrid<Box> grid{};
+        ASSERT_TRUE(reader.read<Box>(i, grid));
+        EXPECT_EQ(grid, puzzles[i]);
+    }
+
+    BasicGrid<Box> grid{};
+    EXPECT_FALSE(reader.read<Box>(puzzles.size(), grid));
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+TEST(PackedCorpusTest, recordSizes)
+{
+    EXPECT_EQ(packedBitsPerCell(9), 4u);
+    EXPECT_EQ(packedBitsPerCell(16), 5u);
+    EXPECT_EQ(packedBitsPerCell(25), 5u);
+    EXPECT_EQ(packedRecordBytes(9), 41u);
+    EXPECT_EQ(packedRecordBytes(16), 160u);
+    EXPECT_EQ(packedRecordBytes(25), 391u);
+}
+
+TEST(PackedCorpusTest, packUnpackRoundTrips)
+{
+    Grid grid{};
+    for(unsigned int cell = 0; cell < grid.size(); ++cell)
+        grid[cell] = static_cast<uint8_t>(cell % 10);
+
+    std::vector<uint8_t> packed(packedRecordBytes(9));
+    packGrid<3>(grid, packed.data());
+    EXPECT_EQ(packed[0], 0x10);
+    EXPECT_EQ(packed[40], 0x0);
+
+    Grid unpacked{};
+    unpackGrid<3>(packed.data(), unpacked);
+    EXPECT_EQ(unpacked, grid);
+
+    BasicGrid<5> large{};
+    for(unsigned int cell = 0; cell < large.size(); ++cell)
+        large[cell] = static_cast<uint8_t>(cell % 26);
+    std::vector<uint8_t> packedLarge(packedRecordBytes(25));
+    packGrid<5>(large, packedLarge.data());
+    BasicGrid<5> unpackedLarge{};
+    unpackGrid<5>(packedLarge.data(), unpackedLarge);
+    EXPECT_EQ(unpackedLarge, large);
+}
+
+TEST(PackedCorpusTest, writerAndReaderRoundTrip)
+{
+    expectRoundTrip<3>(makePuzzles<3>(50, 30), tempPath("sudoku_packed_9.bin"));
+    expectRoundTrip<4>(makePuzzles<4>(3, 150), tempPath("sudoku_packed_16.bin"));
+    expectRoundTrip<3>({}, tempPath("sudoku_packed_empty.bin"));
+}
+
+TEST(PackedCorpusTest, rejectsMismatchedAndMalformedFiles)
+{
+    const std::string path = tempPath("sudoku_packed_bad.bin");
+
+    PackedWriter writer;
+    EXPECT_FALSE(writer.open(path, 10));
+    ASSERT_TRUE(writer.open(path, 9));
+    EXPECT_FALSE(writer.write<4>(BasicGrid<4>{}));
+    ASSERT_TRUE(writer.write<3>(Grid{}));
+    ASSERT_TRUE(writer.close());
+
+    PackedReader reader;
+    ASSERT_TRUE(reader.open(path));
+    BasicGrid<4> large{};
+    EXPECT_FALSE(reader.read<4>(0, large));
+    reader.close();
+
+    // A header that promises more records than the file holds.
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, 8, SEEK_SET);
+    std::fputc(2, file);
+    std::fclose(file);
+    EXPECT_FALSE(reader.open(path));
+
+    file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......\n", file);
+    std::fclose(file);
+    EXPECT_FALSE(PackedReader::isPackedFile(path));
+    EXPECT_FALSE(reader.open(path));
+    EXPECT_FALSE(reader.open(tempPath("sudoku_packed_missing.bin")));
+    std::remove(path.c_str());
+}
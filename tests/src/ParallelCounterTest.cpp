@@ -0,0 +1,79 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ParallelCounter.h"
+#include "Solver.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < Solver::kCells; ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+// A 17-clue puzzle with its first clue removed: 21786 solutions.
+const std::string kSparsePuzzle =
+    "......8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+
+uint64_t serialCount(const Grid& cells, uint64_t limit)
+{
+    Solver solver;
+    return solver.load(cells) ? solver.count(limit) : 0;
+}
+
+} // namespace
+
+TEST(ParallelCounterTest, matchesSerialCount)
+{
+    const Grid cells = cellsFromString(kSparsePuzzle);
+    const uint64_t expected = serialCount(cells, 1000000);
+    ASSERT_EQ(expected, 21786u);
+
+    for(unsigned int threads : {1u, 2u, 4u})
+    {
+        ParallelCounter counter(threads);
+        EXPECT_EQ(counter.count(cells, 1000000), expected) << threads << " threads";
+        EXPECT_GT(counter.nodes(), 0u);
+    }
+}
+
+TEST(ParallelCounterTest, stopsAtLimit)
+{
+    ParallelCounter counter(4);
+    EXPECT_EQ(counter.count(cellsFromString(kSparsePuzzle), 10), 10u);
+    EXPECT_EQ(counter.count(Grid{}, 1000), 1000u);
+    EXPECT_EQ(counter.count(Grid{}, 0), 0u);
+}
+
+TEST(ParallelCounterTest, rejectsInvalidGrids)
+{
+    Grid cells{};
+    cells[0] = 5;
+    cells[1] = 5;
+
+    ParallelCounter counter(2);
+    EXPECT_EQ(counter.count(cells, 10), 0u);
+}
+
+TEST(ParallelCounterTest, countsLargerBoards)
+{
+    BasicSolver<4> solver;
+    ASSERT_TRUE(solver.load(BasicGrid<4>{}));
+    ASSERT_TRUE(solver.solve());
+    BasicGrid<4> solved{};
+    solver.store(solved);
+
+    BasicGrid<4> puzzle = solved;
+    for(unsigned int index = 0; index < puzzle.size(); index += 3)
+        puzzle[index] = 0;
+
+    BasicParallelCounter<4> counter(3);
+    ASSERT_TRUE(solver.load(puzzle));
+    EXPECT_EQ(counter.count(puzzle, 2), solver.count(2));
+    EXPECT_GE(counter.count(puzzle, 2), 1u);
+}
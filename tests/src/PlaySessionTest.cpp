@@ -0,0 +1,174 @@
+#include <bit>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "Board.h"
+#include "PlaySession.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < cells.size(); ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kEasyPuzzle =
+    "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+const std::string kEasySolution =
+    "483921657967345821251876493548132976729564138136798245372689514814253769695417382";
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kHardSolution =
+    "417369825632158947958724316825437169791586432346912758289643571573291684164875293";
+
+} // namespace
+
+TEST(PlaySessionTest, placeAndEraseKeepCandidatesAndConflicts)
+{
+    PlaySession session;
+    ASSERT_TRUE(session.load(cellsFromString(kEasyPuzzle)));
+    EXPECT_EQ(session.filledCount(), 32u);
+    EXPECT_EQ(session.conflictCount(), 0u);
+    EXPECT_TRUE(session.isGiven(2));
+    EXPECT_FALSE(session.isGiven(0));
+
+    // Row 0 holds 2, 3 and 6, column 0 holds 7, 8 and 9, and box 0 holds 1,
+    // 3 and 9.
+    EXPECT_EQ(session.candidates(0), (1u << 4) | (1u << 5));
+    EXPECT_EQ(session.candidates(2), 0u);
+
+    EXPECT_TRUE(session.place(0, 4));
+    EXPECT_EQ(session.digit(0), 4u);
+    EXPECT_EQ(session.candidates(1), (1u << 5) | (1u << 7) | (1u << 8));
+    EXPECT_FALSE(session.hasConflict(0));
+
+    // A 2 clashes with the given 2 of row 0; conflicts are reported, not refused.
+    EXPECT_TRUE(session.place(1, 2));
+    EXPECT_TRUE(session.hasConflict(1));
+    EXPECT_TRUE(session.hasConflict(4));
+    EXPECT_EQ(session.conflictCount(), 1u);
+    EXPECT_FALSE(session.hint().has_value());
+
+    EXPECT_TRUE(session.erase(1));
+    EXPECT_FALSE(session.hasConflict(4));
+    EXPECT_EQ(session.conflictCount(), 0u);
+    EXPECT_EQ(session.filledCount(), 33u);
+
+    EXPECT_FALSE(session.place(2, 5));
+    EXPECT_FALSE(session.erase(2));
+    EXPECT_FALSE(session.place(81, 1));
+    EXPECT_FALSE(session.place(0, 10));
+    EXPECT_EQ(session.digit(2), 3u);
+
+    Grid invalid = cellsFromString(kEasyPuzzle);
+    invalid[0] = 10;
+    EXPECT_FALSE(session.load(invalid));
+    EXPECT_EQ(session.digit(0), 4u);
+}
+
+TEST(PlaySessionTest, undoAndRedoReplayMoves)
+{
+    PlaySession session;
+    ASSERT_TRUE(session.load(cellsFromString(kEasyPuzzle)));
+    EXPECT_FALSE(session.undo());
+    EXPECT_FALSE(session.redo());
+
+    const Grid start = session.grid();
+    ASSERT_TRUE(session.place(0, 4));
+    ASSERT_TRUE(session.place(0, 5));
+    ASSERT_TRUE(session.place(1, 5));
+    // The same digit again is not a move.
+    ASSERT_TRUE(session.place(1, 5));
+    const Grid end = session.grid();
+    EXPECT_EQ(session.conflictCount(), 2u);
+
+    EXPECT_TRUE(session.undo());
+    EXPECT_EQ(session.conflictCount(), 0u);
+    EXPECT_TRUE(session.undo());
+    EXPECT_EQ(session.digit(0), 4u);
+    EXPECT_TRUE(session.undo());
+    EXPECT_FALSE(session.undo());
+    EXPECT_EQ(session.grid(), start);
+    EXPECT_EQ(session.filledCount(), 32u);
+
+    EXPECT_TRUE(session.redo());
+    EXPECT_TRUE(session.redo());
+    EXPECT_TRUE(session.redo());
+    EXPECT_FALSE(session.redo());
+    EXPECT_EQ(session.grid(), end);
+    EXPECT_EQ(session.conflictCount(), 2u);
+
+    // A new move after an undo drops the undone moves.
+    EXPECT_TRUE(session.undo());
+    EXPECT_TRUE(session.place(7, 7));
+    EXPECT_FALSE(session.canRedo());
+    EXPECT_EQ(session.digit(1), 0u);
+    EXPECT_EQ(session.digit(7), 7u);
+}
+
+TEST(PlaySessionTest, hintsSolveThePuzzle)
+{
+    for(const auto& [puzzle, solution] : {std::pair{kEasyPuzzle, kEasySolution}, std::pair{kHardPuzzle, kHardSolution}})
+    {
+        PlaySession session;
+        ASSERT_TRUE(session.load(cellsFromString(puzzle)));
+        const Grid expected = cellsFromString(solution);
+        unsigned int fromSolution = 0;
+        while(std::optional<Hint> hint = session.hint())
+        {
+            EXPECT_EQ(hint->digit, expected[hint->cell]);
+            fromSolution += hint->reason == HintReason::Solution ? 1 : 0;
+            ASSERT_TRUE(session.place(hint->cell, hint->digit));
+        }
+        EXPECT_TRUE(session.isSolved());
+        EXPECT_EQ(session.grid(), expected);
+        // The easy puzzle falls to singles alone; the hard one does not.
+        EXPECT_EQ(fromSolution == 0, puzzle == kEasyPuzzle);
+    }
+}
+
+TEST(PlaySessionTest, hiddenSingleIsFoundWithoutNakedSingles)
+{
+    // A 1 in each of columns 1-8, none in box 0, leaves cell 0 as the only
+    // place for 1 in row 0, while every open cell keeps several candidates.
+    Grid puzzle{};
+    for(auto [row, column] : {std::pair{3, 1}, {6, 2}, {1, 3}, {4, 4}, {7, 5}, {2, 6}, {5, 7}, {8, 8}})
+        puzzle[row * 9 + column] = 1;
+    PlaySession session;
+    ASSERT_TRUE(session.load(puzzle));
+    EXPECT_EQ(std::popcount(session.candidates(0)), 9);
+
+    const std::optional<Hint> hint = session.hint();
+    ASSERT_TRUE(hint.has_value());
+    EXPECT_EQ(hint->cell, 0u);
+    EXPECT_EQ(hint->digit, 1u);
+    EXPECT_EQ(hint->reason, HintReason::HiddenSingle);
+}
+
+TEST(PlaySessionTest, largerBoardsKeepTheSameBookkeeping)
+{
+    BasicBoard<4> board(3);
+    ASSERT_TRUE(board.generateSolution());
+    BasicGrid<4> puzzle = board.getBoardData();
+    const BasicGrid<4> solution = puzzle;
+    for(unsigned int cell = 0; cell < puzzle.size(); cell += 3)
+        puzzle[cell] = 0;
+
+    BasicPlaySession<4> session;
+    ASSERT_TRUE(session.load(puzzle));
+    for(unsigned int cell = 0; cell < puzzle.size(); cell += 3)
+    {
+        EXPECT_EQ(session.candidates(cell) & (1u << solution[cell]), 1u << solution[cell]);
+        ASSERT_TRUE(session.place(cell, solution[cell]));
+    }
+    EXPECT_TRUE(session.isSolved());
+    while(session.undo())
+        ;
+    EXPECT_EQ(session.grid(), puzzle);
+    EXPECT_EQ(session.conflictCount(), 0u);
+}
@@ -0,0 +1,88 @@
+#include <array>
+#include <set>
+
+#include "gtest/gtest.h"
+#include "Random.h"
+
+using namespace sudoku;
+
+TEST(RandomTest, derivedSeedsAreStableAndDistinct)
+{
+    static_assert(deriveSeed(42, 7) == deriveSeed(42, 7));
+
+    std::set<uint32_t> seeds;
+    for(uint64_t index = 0; index < 10000; ++index)
+        seeds.insert(deriveSeed(42, index));
+    EXPECT_EQ(seeds.size(), 10000u);
+
+    EXPECT_NE(deriveSeed(42, 0), deriveSeed(43, 0));
+    EXPECT_NE(deriveSeed(0, 0), deriveSeed(0, 1));
+}
+
+TEST(RandomTest, enginesAreDeterministicPerSeed)
+{
+    Xoshiro256PlusPlus first(7);
+    Xoshiro256PlusPlus second(7);
+    Pcg32 pcg(7);
+    Pcg32 pcgAgain(7);
+    for(unsigned int draw = 0; draw < 100; ++draw)
+    {
+        EXPECT_EQ(first(), second());
+        EXPECT_EQ(pcg(), pcgAgain());
+    }
+
+    first.seed(8);
+    second.seed(9);
+    EXPECT_NE(first(), second());
+    pcg.seed(8);
+    pcgAgain.seed(9);
+    EXPECT_NE(pcg(), pcgAgain());
+
+    // Copies continue the same stream.
+    Xoshiro256PlusPlus copy = first;
+    EXPECT_EQ(copy, first);
+    EXPECT_EQ(copy(), first());
+}
+
+TEST(RandomTest, randomSetBitDrawsEveryCandidateEvenly)
+{
+    Pcg32 rng(3);
+    const uint32_t mask = 0b1010010110;
+    std::array<unsigned int, 32> hits{};
+    constexpr unsigned int kDraws = 50000;
+    for(unsigned int draw = 0; draw < kDraws; ++draw)
+        ++hits[randomSetBit(rng, mask)];
+
+    for(unsigned int bit = 0; bit < 32; ++bit)
+    {
+        if((mask & (1u << bit)) == 0)
+        {
+            EXPECT_EQ(hits[bit], 0u) << bit;
+            continue;
+        }
+        // Five candidates: each expected 10000 times, sigma about 90.
+        EXPECT_NEAR(hits[bit], kDraws / 5, 600) << bit;
+    }
+
+    Xoshiro256PlusPlus engine(1);
+    for(uint32_t bound : {1u, 2u, 7u, 81u, 1000000u})
+    {
+        for(unsigned int draw = 0; draw < 1000; ++draw)
+            EXPECT_LT(uniformBelow(engine, bound), bound);
+    }
+}
+
+TEST(RandomTest, shuffleRangeIsAPermutation)
+{
+    std::array<unsigned int, 81> values{};
+    for(unsigned int index = 0; index < values.size(); ++index)
+        values[index] = index;
+
+    Xoshiro256PlusPlus rng(5);
+    std::array<unsigned int, 81> shuffled = values;
+    shuffleRange(shuffled.begin(), shuffled.end(), rng);
+    EXPECT_NE(shuffled, values);
+
+    std::set<unsigned int> seen(shuffled.begin(), shuffled.end());
+    EXPECT_EQ(seen.size(), values.size());
+}
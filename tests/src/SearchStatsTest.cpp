@@ -0,0 +1,130 @@
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "BitboardSolver.h"
+#include "Board.h"
+#include "DlxSolver.h"
+#include "SearchStats.h"
+#include "Solver.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < Solver::kCells; ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+// Project Euler 96, grid 1: singles alone solve it.
+const std::string kEasyPuzzle =
+    "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+
+template <typename Engine>
+void expectConsistentCount(Engine& engine)
+{
+    SearchStats stats;
+    engine.setSearchStats(&stats);
+    ASSERT_TRUE(engine.load(cellsFromString(kHardPuzzle)));
+    EXPECT_EQ(engine.count(2), 1u);
+
+    EXPECT_EQ(stats.nodes, engine.nodes());
+    EXPECT_GT(stats.backtracks, 0u);
+    EXPECT_GT(stats.maxDepth, 0u);
+    EXPECT_GT(stats.scannedCells, 0u);
+    // Leaves and dead ends do not branch.
+    EXPECT_LE(stats.branchingNodes(), stats.nodes);
+    EXPECT_GT(stats.averageBranching(), 1.0);
+    engine.setSearchStats(nullptr);
+}
+
+} // namespace
+
+TEST(SearchStatsTest, detachedEnginesRecordNothing)
+{
+    SearchStats stats;
+    Solver solver;
+    solver.setSearchStats(&stats);
+    solver.setSearchStats(nullptr);
+    ASSERT_TRUE(solver.load(cellsFromString(kHardPuzzle)));
+    ASSERT_TRUE(solver.solve());
+    EXPECT_EQ(stats.nodes, 0u);
+    EXPECT_EQ(stats.branchingNodes(), 0u);
+}
+
+TEST(SearchStatsTest, enginesReportTheirSearch)
+{
+    if(!kSearchStatsEnabled)
+        GTEST_SKIP() << "Built with SUDOKU_NO_SEARCH_STATS";
+
+    Solver solver;
+    expectConsistentCount(solver);
+    DlxSolver dlx;
+    expectConsistentCount(dlx);
+    BitboardSolver bitboard;
+    expectConsistentCount(bitboard);
+}
+
+TEST(SearchStatsTest, propagationAloneNeedsNoBranching)
+{
+    if(!kSearchStatsEnabled)
+        GTEST_SKIP() << "Built with SUDOKU_NO_SEARCH_STATS";
+
+    SearchStats stats;
+    Solver solver;
+    solver.setSearchStats(&stats);
+    ASSERT_TRUE(solver.load(cellsFromString(kEasyPuzzle)));
+    ASSERT_TRUE(solver.solve());
+    EXPECT_EQ(stats.nodes, 1u);
+    EXPECT_EQ(stats.backtracks, 0u);
+    EXPECT_EQ(stats.maxDepth, 0u);
+    EXPECT_EQ(stats.branchingNodes(), 0u);
+    EXPECT_GT(stats.propagations, 0u);
+}
+
+TEST(SearchStatsTest, boardCollectsPerCallWhenEnabled)
+{
+    Board board(5);
+    ASSERT_TRUE(board.loadFromString(kHardPuzzle));
+    board.countSolutions(2);
+    EXPECT_EQ(board.getLastSearchStats().nodes, 0u);
+
+    board.setSearchStatsEnabled(true);
+    board.countSolutions(2);
+    const uint64_t expected = kSearchStatsEnabled ? board.getLastSearchNodes() : 0;
+    EXPECT_EQ(board.getLastSearchStats().nodes, expected);
+
+    // A second call starts from zero rather than adding on.
+    board.countSolutions(2, SolverBackend::Dlx);
+    EXPECT_EQ(board.getLastSearchStats().nodes, kSearchStatsEnabled ? board.getLastSearchNodes() : 0);
+}
+
+TEST(SearchStatsTest, mergeAndPrint)
+{
+    SearchStats first;
+    first.nodes = 3;
+    first.maxDepth = 2;
+    first.branching[2] = 2;
+    SearchStats second;
+    second.nodes = 4;
+    second.backtracks = 1;
+    second.maxDepth = 5;
+    second.branching[3] = 1;
+
+    first.merge(second);
+    EXPECT_EQ(first.nodes, 7u);
+    EXPECT_EQ(first.backtracks, 1u);
+    EXPECT_EQ(first.maxDepth, 5u);
+    EXPECT_EQ(first.branchingNodes(), 3u);
+    EXPECT_NEAR(first.averageBranching(), 7.0 / 3.0, 1e-9);
+
+    std::ostringstream text;
+    text << first;
+    EXPECT_EQ(text.str(), "nodes=7 backtracks=1 propagations=0 maxDepth=5 scanned=0 branching=2:2,3:1");
+}
@@ -0,0 +1,293 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "Server.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace sudoku;
+
+namespace {
+
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kHardSolution =
+    "417369825632158947958724316825437169791586432346912758289643571573291684164875293";
+// Seven solutions.
+const std::string kOpenPuzzle =
+    "..7..9.2.6.....94....724.1...54..1.9..1.8.....4.....5.2..6...71573.....4.6..7...3";
+
+RequestServer::Options serverOptions(unsigned int threads, std::size_t cacheSize = 0)
+{
+    RequestServer::Options options;
+    options.threads = threads;
+    options.cacheSize = cacheSize;
+    options.masterSeed = 9;
+    return options;
+}
+
+#ifndef _WIN32
+// Connects to the server's socket, retrying while it starts listening.
+int connectTo(const std::string& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, path.size());
+    for(unsigned int attempt = 0; attempt < 200; ++attempt)
+    {
+        const int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if(client < 0)
+            return -1;
+        if(::connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0)
+            return client;
+        ::close(client);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return -1;
+}
+#endif
+
+} // namespace
+
+TEST(ServerTest, handleAnswersEachRequestKind)
+{
+    for(std::size_t cacheSize : {std::size_t{0}, std::size_t{64}})
+    {
+        RequestServer server(serverOptions(1, cacheSize));
+        EXPECT_EQ(server.handle("solve " + kHardPuzzle, 0), "ok " + kHardSolution);
+        EXPECT_EQ(server.handle("count " + kOpenPuzzle + " limit 100", 0), "ok 7");
+        EXPECT_EQ(server.handle("count " + kHardPuzzle, 0), "ok 1");
+        EXPECT_EQ(server.handle("validate " + kHardPuzzle, 0), "ok unique");
+        EXPECT_EQ(server.handle("validate " + kOpenPuzzle, 0), "ok multiple");
+
+        const std::string generated = server.handle("generate clues 28 seed 4", 0);
+        ASSERT_EQ(generated.size(), 3u + 81u);
+        EXPECT_EQ(generated, server.handle("generate seed 4 clues 28", 0));
+        EXPECT_EQ(server.handle("validate " + generated.substr(3), 0), "ok unique");
+        EXPECT_EQ(server.handle("generate solution seed 1", 0).find('.'), std::string::npos);
+    }
+}
+
+TEST(ServerTest, rejectsMalformedRequests)
+{
+    RequestServer server(serverOptions(1));
+    EXPECT_EQ(server.handle("", 0), "error empty request");
+    EXPECT_EQ(server.handle("shuffle", 0), "error unknown request");
+    EXPECT_EQ(server.handle("solve 12345", 0), "error invalid puzzle");
+    EXPECT_EQ(server.handle("count " + kHardPuzzle + " limit 0", 0), "error invalid limit");
+    EXPECT_EQ(server.handle("generate clues", 0), "error missing value");
+    EXPECT_EQ(server.handle("generate difficulty impossible", 0), "error invalid generate option");
+
+    std::string conflicting = kHardPuzzle;
+    conflicting[1] = '4';
+    EXPECT_EQ(server.handle("solve " + conflicting, 0), "error unsolvable");
+    EXPECT_EQ(server.handle("validate " + conflicting, 0), "ok unsolvable");
+}
+
+TEST(ServerTest, pipelinedRequestsAreAnsweredInOrder)
+{
+    RequestServer reference(serverOptions(1));
+    std::string requests;
+    std::string expected;
+    for(unsigned int index = 0; index < 300; ++index)
+    {
+        std::string request;
+        switch(index % 3)
+        {
+            case 0: request = "generate clues 30 seed " + std::to_string(index); break;
+            case 1: request = "solve " + kHardPuzzle; break;
+            default: request = "count " + kOpenPuzzle + " limit " + std::to_string(index % 9 + 1); break;
+        }
+        requests += request + "\r\n\n";
+        expected += reference.handle(request, 0) + "\n";
+    }
+
+    RequestServer server(serverOptions(4));
+    std::istringstream input(requests);
+    std::ostringstream output;
+    server.serve(input, output);
+    EXPECT_EQ(output.str(), expected);
+}
+
+TEST(ServerTest, searchTimeoutAnswersTimeoutAndKeepsServing)
+{
+    for(std::size_t cacheSize : {std::size_t{0}, std::size_t{64}})
+    {
+        RequestServer::Options options = serverOptions(1, cacheSize);
+        options.searchTimeout = std::chrono::milliseconds(20);
+        RequestServer server(options);
+
+        // Counting a billion solutions of the empty grid cannot finish in time.
+        const std::string empty(81, '.');
+        EXPECT_EQ(server.handle("count " + empty + " limit 1000000000", 0), "error timeout");
+
+        EXPECT_EQ(server.handle("solve " + kHardPuzzle, 0), "ok " + kHardSolution);
+        EXPECT_EQ(server.handle("count " + kOpenPuzzle + " limit 100", 0), "ok 7");
+        EXPECT_EQ(server.handle("validate " + kOpenPuzzle, 0), "ok multiple");
+        EXPECT_EQ(server.handle("validate " + kHardPuzzle, 0), "ok unique");
+    }
+}
+
+#ifndef _WIN32
+TEST(ServerTest, unixSocketServesConnections)
+{
+    const std::string path = "/tmp/sudoku-server-test-" + std::to_string(::getpid()) + ".sock";
+    RequestServer server(serverOptions(2));
+    bool served = false;
+    std::thread listener([&] { served = server.serveUnixSocket(path); });
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, path.size());
+    const int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(client, 0);
+    bool connected = false;
+    for(unsigned int attempt = 0; attempt < 200 && !connected; ++attempt)
+    {
+        connected = ::connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        if(!connected)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(connected);
+
+    const std::string requests = "validate " + kHardPuzzle + "\nsolve " + kHardPuzzle + "\n";
+    ASSERT_EQ(::send(client, requests.data(), requests.size(), 0), static_cast<ssize_t>(requests.size()));
+    ::shutdown(client, SHUT_WR);
+
+    std::string answers;
+    char buffer[256];
+    ssize_t received = 0;
+    while((received = ::recv(client, buffer, sizeof(buffer), 0)) > 0)
+        answers.append(buffer, static_cast<std::size_t>(received));
+    ::close(client);
+    EXPECT_EQ(answers, "ok unique\nok " + kHardSolution + "\n");
+
+    server.stop();
+    listener.join();
+    EXPECT_TRUE(served);
+}
+
+TEST(ServerTest, clientThatNeverReadsHoldsNoOtherConnection)
+{
+    const std::string path = "/tmp/sudoku-server-stall-" + std::to_string(::getpid()) + ".sock";
+    RequestServer server(serverOptions(2));
+    bool served = false;
+    std::thread listener([&] { served = server.serveUnixSocket(path); });
+
+    // Pipelines far more answers than the socket buffers hold, and never
+    // reads them; the sender blocks once the server stops reading too.
+    const int stalled = connectTo(path);
+    ASSERT_GE(stalled, 0);
+    std::thread sender([stalled] {
+        std::string requests;
+        for(unsigned int index = 0; index < 1000; ++index)
+            requests += "solve " + kHardSolution + "\n";
+        for(unsigned int round = 0; round < 50; ++round)
+        {
+            for(std::size_t sent = 0; sent < requests.size();)
+            {
+                const ssize_t written = ::send(stalled, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+                if(written <= 0)
+                    return;
+                sent += static_cast<std::size_t>(written);
+            }
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    const int client = connectTo(path);
+    ASSERT_GE(client, 0);
+    timeval timeout{5, 0};
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    const std::string request = "validate " + kHardPuzzle + "\n";
+    ASSERT_EQ(::send(client, request.data(), request.size(), MSG_NOSIGNAL), static_cast<ssize_t>(request.size()));
+    char buffer[64];
+    const ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+    ASSERT_GT(received, 0);
+    EXPECT_EQ(std::string(buffer, static_cast<std::size_t>(received)), "ok unique\n");
+    ::close(client);
+
+    // Ends the blocked write on the stalled connection, so the listener
+    // can join its connection threads.
+    server.stop();
+    listener.join();
+    sender.join();
+    ::close(stalled);
+    EXPECT_TRUE(served);
+}
+
+TEST(ServerTest, connectionsBeyondTheCapWaitForOneToEnd)
+{
+    const std::string path = "/tmp/sudoku-server-cap-" + std::to_string(::getpid()) + ".sock";
+    RequestServer::Options options = serverOptions(1);
+    options.maxConnections = 1;
+    RequestServer server(options);
+    bool served = false;
+    std::thread listener([&] { served = server.serveUnixSocket(path); });
+
+    const std::string request = "validate " + kHardPuzzle + "\n";
+    auto ask = [&](int client, long timeoutMs) {
+        timeval timeout{0, timeoutMs * 1000};
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        if(::send(client, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size()))
+            return std::string();
+        char buffer[64];
+        const ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+        return received > 0 ? std::string(buffer, static_cast<std::size_t>(received)) : std::string();
+    };
+
+    // Sequential connections each end before the next, so none waits.
+    for(unsigned int round = 0; round < 20; ++round)
+    {
+        const int client = connectTo(path);
+        ASSERT_GE(client, 0);
+        EXPECT_EQ(ask(client, 900), "ok unique\n");
+        ::close(client);
+    }
+
+    const int first = connectTo(path);
+    ASSERT_GE(first, 0);
+    EXPECT_EQ(ask(first, 900), "ok unique\n");
+    // Connects through the backlog but is not served while the first is open.
+    const int second = connectTo(path);
+    ASSERT_GE(second, 0);
+    EXPECT_EQ(ask(second, 200), "");
+    ::close(first);
+
+    timeval timeout{5, 0};
+    ::setsockopt(second, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    char buffer[64];
+    const ssize_t received = ::recv(second, buffer, sizeof(buffer), 0);
+    ASSERT_GT(received, 0);
+    EXPECT_EQ(std::string(buffer, static_cast<std::size_t>(received)), "ok unique\n");
+    ::close(second);
+
+    server.stop();
+    listener.join();
+    EXPECT_TRUE(served);
+}
+
+TEST(ServerTest, socketPathHoldingAFileIsLeftAlone)
+{
+    const std::string path = "/tmp/sudoku-server-file-" + std::to_string(::getpid()) + ".sock";
+    {
+        std::ofstream file(path);
+        file << "keep";
+    }
+    RequestServer server(serverOptions(1));
+    EXPECT_FALSE(server.serveUnixSocket(path));
+
+    std::ifstream file(path);
+    std::string contents;
+    file >> contents;
+    EXPECT_EQ(contents, "keep");
+    ::unlink(path.c_str());
+}
+#endif
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Board.h"
+#include "Canonical.h"
+#include "SolutionSampler.h"
+
+using namespace sudoku;
+
+namespace {
+
+bool isSolvedGrid(const Grid& grid)
+{
+    Board board;
+    return std::count(grid.begin(), grid.end(), 0) == 0 && board.loadFromData(grid);
+}
+
+} // namespace
+
+TEST(SolutionSamplerTest, transformFromWordKeepsBandsAndStacks)
+{
+    const GridTransform identity = transformFromWord(0);
+    EXPECT_FALSE(identity.transpose);
+    EXPECT_EQ(identity.rows, GridTransform{}.rows);
+    EXPECT_EQ(identity.columns, GridTransform{}.columns);
+
+    Board board(3);
+    ASSERT_TRUE(board.generateSolution());
+    const Grid solution = board.getBoardData();
+
+    Xoshiro256PlusPlus rng(8);
+    unsigned int transposed = 0;
+    for(unsigned int sample = 0; sample < 200; ++sample)
+    {
+        const GridTransform transform = transformFromWord(rng());
+        transposed += transform.transpose ? 1 : 0;
+        for(unsigned int line = 0; line < 9; ++line)
+        {
+            EXPECT_EQ(transform.rows[line] / 3, transform.rows[line - line % 3] / 3);
+            EXPECT_EQ(transform.columns[line] / 3, transform.columns[line - line % 3] / 3);
+        }
+        std::array<uint8_t, 10> digits = transform.digits;
+        std::sort(digits.begin(), digits.end());
+        EXPECT_EQ(digits, GridTransform{}.digits);
+        EXPECT_TRUE(isSolvedGrid(transformGrid(transform, solution)));
+    }
+    EXPECT_GT(transposed, 50u);
+    EXPECT_LT(transposed, 150u);
+}
+
+TEST(SolutionSamplerTest, drawsValidGridsDeterministically)
+{
+    SolutionSampler::Options options;
+    options.poolSize = 4;
+    SolutionSampler sampler(11, options);
+    SolutionSampler same(11, options);
+    EXPECT_EQ(sampler.poolSize(), 4u);
+
+    std::vector<Grid> grids(300);
+    std::vector<Grid> repeated(grids.size());
+    sampler.fill(grids);
+    same.fill(repeated);
+    EXPECT_EQ(grids, repeated);
+
+    std::set<Grid> distinct;
+    std::set<Grid> classes;
+    for(const Grid& grid : grids)
+    {
+        EXPECT_TRUE(isSolvedGrid(grid));
+        distinct.insert(grid);
+        classes.insert(canonicalize(grid).grid);
+    }
+    EXPECT_EQ(distinct.size(), grids.size());
+    // Every grid is a transform of one of the four seeds.
+    EXPECT_LE(classes.size(), 4u);
+    EXPECT_EQ(sampler.searchedSeeds(), 4u);
+}
+
+TEST(SolutionSamplerTest, freshIntervalMixesInSearchedSeeds)
+{
+    SolutionSampler::Options options;
+    options.poolSize = 1;
+    SolutionSampler fixed(5, options);
+    std::set<Grid> fixedClasses;
+    for(unsigned int index = 0; index < 20; ++index)
+    {
+        Grid grid;
+        fixed.next(grid);
+        fixedClasses.insert(canonicalize(grid).grid);
+    }
+    EXPECT_EQ(fixedClasses.size(), 1u);
+    EXPECT_EQ(fixed.searchedSeeds(), 1u);
+
+    options.freshInterval = 4;
+    SolutionSampler fresh(5, options);
+    std::vector<Grid> grids(20);
+    fresh.fill(grids);
+    EXPECT_EQ(fresh.searchedSeeds(), 1u + 5u);
+
+    // Grids drawn between two refreshes share their seed.
+    std::set<Grid> freshClasses;
+    for(std::size_t index = 0; index < grids.size(); ++index)
+    {
+        EXPECT_TRUE(isSolvedGrid(grids[index]));
+        freshClasses.insert(canonicalize(grids[index]).grid);
+        if(index % 4 != 2 && index + 1 < grids.size())
+        {
+            EXPECT_EQ(canonicalize(grids[index]).grid, canonicalize(grids[index + 1]).grid) << index;
+        }
+    }
+    EXPECT_GT(freshClasses.size(), 1u);
+}
@@ -0,0 +1,119 @@
+#include <string>
+
+#include "gtest/gtest.h"
+#include "Board.h"
+#include "SolveCache.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < cells.size(); ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kEasyPuzzle =
+    "003020600900305001001806400008102900700000008006708200002609500800203009005010300";
+// Seven solutions.
+const std::string kOpenPuzzle =
+    "..7..9.2.6.....94....724.1...54..1.9..1.8.....4.....5.2..6...71573.....4.6..7...3";
+
+GridTransform sampleTransform()
+{
+    GridTransform transform;
+    transform.transpose = true;
+    transform.rows = {5, 3, 4, 8, 6, 7, 1, 2, 0};
+    transform.columns = {2, 0, 1, 6, 8, 7, 3, 5, 4};
+    transform.digits = {0, 4, 9, 1, 7, 2, 8, 3, 6, 5};
+    return transform;
+}
+
+} // namespace
+
+TEST(SolveCacheTest, transformedPuzzleHitsAndMapsBack)
+{
+    Board board(1);
+    SolveCache cache(16);
+    const Grid puzzle = cellsFromString(kHardPuzzle);
+    const SolveResult first = cache.solve(puzzle, board);
+    ASSERT_EQ(first.status, SolveStatus::Unique);
+
+    Board reference;
+    ASSERT_TRUE(reference.loadFromData(puzzle));
+    ASSERT_TRUE(reference.solve());
+    EXPECT_EQ(first.solution, reference.getBoardData());
+
+    const GridTransform transform = sampleTransform();
+    const SolveResult second = cache.solve(transformGrid(transform, puzzle), board);
+    EXPECT_EQ(second.status, SolveStatus::Unique);
+    EXPECT_EQ(second.solution, transformGrid(transform, first.solution));
+
+    const SolveCacheCounters counters = cache.counters();
+    EXPECT_EQ(counters.misses, 1u);
+    EXPECT_EQ(counters.hits, 1u);
+    EXPECT_EQ(counters.evictions, 0u);
+}
+
+TEST(SolveCacheTest, reportsUniquenessStatus)
+{
+    Board board(2);
+    SolveCache cache(16);
+    EXPECT_EQ(cache.solve(cellsFromString(kEasyPuzzle), board).status, SolveStatus::Unique);
+
+    const Grid open = cellsFromString(kOpenPuzzle);
+    const SolveResult multiple = cache.solve(open, board);
+    EXPECT_EQ(multiple.status, SolveStatus::Multiple);
+    for(unsigned int index = 0; index < open.size(); ++index)
+    {
+        if(open[index] != 0)
+        {
+            EXPECT_EQ(multiple.solution[index], open[index]);
+        }
+    }
+
+    Grid conflicting = cellsFromString(kEasyPuzzle);
+    conflicting[0] = conflicting[2];
+    const SolveResult unsolvable = cache.solve(conflicting, board);
+    EXPECT_EQ(unsolvable.status, SolveStatus::Unsolvable);
+    EXPECT_EQ(unsolvable.solution, Grid{});
+}
+
+TEST(SolveCacheTest, clockGivesReferencedEntriesASecondChance)
+{
+    Board board(3);
+    SolveCache cache(2);
+    const Grid hard = cellsFromString(kHardPuzzle);
+    const Grid easy = cellsFromString(kEasyPuzzle);
+    const Grid open = cellsFromString(kOpenPuzzle);
+
+    cache.solve(hard, board);
+    cache.solve(easy, board);
+    cache.solve(hard, board);
+    // Full: the hand passes over the referenced hard puzzle and evicts easy.
+    cache.solve(open, board);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.counters().evictions, 1u);
+
+    cache.solve(hard, board);
+    EXPECT_EQ(cache.counters().hits, 2u);
+    cache.solve(easy, board);
+    EXPECT_EQ(cache.counters().misses, 4u);
+}
+
+TEST(SolveCacheTest, zeroCapacityNeverStores)
+{
+    Board board(4);
+    SolveCache cache(0);
+    const Grid puzzle = cellsFromString(kEasyPuzzle);
+    EXPECT_EQ(cache.solve(puzzle, board).status, SolveStatus::Unique);
+    EXPECT_EQ(cache.solve(puzzle, board).status, SolveStatus::Unique);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.counters().misses, 2u);
+    EXPECT_EQ(cache.counters().hits, 0u);
+}
@@ -0,0 +1,149 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "Board.h"
+#include "SolverContext.h"
+
+using namespace sudoku;
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+
+} // namespace
+
+// Counts every plain allocation in the test binary; only the difference
+// across a stretch of code is meaningful.
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+TEST(SolverContextTest, boardsLeaseContextsFromThePool)
+{
+    // Start from a known pool state on this thread.
+    std::vector<Board> warm(3);
+    warm.clear();
+    const std::size_t idle = SolverContext::pooled();
+    ASSERT_GE(idle, 3u);
+
+    {
+        Board board;
+        EXPECT_EQ(SolverContext::pooled(), idle - 1);
+        Board copy(board);
+        EXPECT_EQ(SolverContext::pooled(), idle - 2);
+        // The moved-from board leases a context of its own.
+        Board moved(std::move(copy));
+        EXPECT_EQ(SolverContext::pooled(), idle - 3);
+    }
+    EXPECT_EQ(SolverContext::pooled(), idle);
+
+    // Pools are per thread.
+    std::thread([] {
+        EXPECT_EQ(SolverContext::pooled(), 0u);
+        { Board board; }
+        EXPECT_EQ(SolverContext::pooled(), 1u);
+    }).join();
+    EXPECT_EQ(SolverContext::pooled(), idle);
+}
+
+TEST(SolverContextTest, unseededBoardsDoNotContinuePooledStreams)
+{
+    // Each unseeded board follows a seeded one through the same pooled
+    // context; continuing that context's stream would repeat the grid.
+    auto afterSeededBoard = [] {
+        {
+            Board seeded(42);
+            seeded.generateSolution();
+        }
+        Board board;
+        board.generateSolution();
+        return board.toString();
+    };
+    EXPECT_NE(afterSeededBoard(), afterSeededBoard());
+}
+
+TEST(SolverContextTest, movedFromBoardsStayUsable)
+{
+    Board source(1);
+    ASSERT_TRUE(source.generatePuzzle(28));
+    const std::string puzzle = source.toString();
+    Board moved(std::move(source));
+    EXPECT_EQ(moved.toString(), puzzle);
+    EXPECT_TRUE(moved.solve());
+
+    ASSERT_TRUE(source.loadFromString(std::string(81, '.')));
+    EXPECT_TRUE(source.solve());
+    source.setSeed(2);
+    const Board copy(source);
+    EXPECT_EQ(copy.toString(), source.toString());
+
+    Board assigned;
+    assigned = std::move(moved);
+    EXPECT_TRUE(moved.loadFromString(puzzle));
+    EXPECT_EQ(moved.countSolutions(2), 1u);
+}
+
+TEST(SolverContextTest, reusedContextsStartFromDefaultSettings)
+{
+    {
+        Board board;
+        board.setPropagationEnabled(false);
+    }
+    Board board;
+    EXPECT_TRUE(board.isPropagationEnabled());
+}
+
+TEST(SolverContextTest, seededBoardsDoNotDependOnPooling)
+{
+    std::string first;
+    {
+        Board board(7);
+        ASSERT_TRUE(board.generatePuzzle(28));
+        first = board.toString();
+    }
+
+    // The same context comes back from the pool, reseeded.
+    Board board(7);
+    ASSERT_TRUE(board.generatePuzzle(28));
+    EXPECT_EQ(board.toString(), first);
+
+    // A copy carries the random state along.
+    Board original(11);
+    Board copy(original);
+    ASSERT_TRUE(original.generatePuzzle(28));
+    ASSERT_TRUE(copy.generatePuzzle(28));
+    EXPECT_EQ(original.toString(), copy.toString());
+}
+
+TEST(SolverContextTest, pooledBoardsAllocateNothingAfterWarmUp)
+{
+    auto run = [] {
+        Board board(5);
+        board.generatePuzzle(28);
+        board.solve();
+        board.generatePuzzle(Difficulty::Medium);
+    };
+    run();
+
+    const uint64_t before = allocations.load();
+    run();
+    EXPECT_EQ(allocations.load(), before);
+}
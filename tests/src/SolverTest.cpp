@@ -0,0 +1,292 @@
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Solver.h"
+
+using namespace sudoku;
+
+namespace {
+
+Grid cellsFromString(const std::string& text)
+{
+    Grid cells{};
+    for(unsigned int index = 0; index < Solver::kCells; ++index)
+        cells[index] = text[index] == '.' ? 0 : static_cast<uint8_t>(text[index] - '0');
+    return cells;
+}
+
+const std::string kHardPuzzle =
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......";
+const std::string kHardSolution =
+    "417369825632158947958724316825437169791586432346912758289643571573291684164875293";
+
+} // namespace
+
+TEST(SolverTest, solveFindsTheUniqueSolution)
+{
+    Solver solver;
+    ASSERT_TRUE(solver.load(cellsFromString(kHardPuzzle)));
+    ASSERT_TRUE(solver.solve());
+
+    Grid solved{};
+    solver.store(solved);
+    EXPECT_EQ(solved, cellsFromString(kHardSolution));
+}
+
+TEST(SolverTest, countRestoresLoadedStateAndCanRepeat)
+{
+    Solver solver;
+    const Grid cells = cellsFromString(kHardPuzzle);
+    ASSERT_TRUE(solver.load(cells));
+    EXPECT_EQ(solver.count(2), 1u);
+    EXPECT_EQ(solver.count(2), 1u);
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, cells);
+}
+
+TEST(SolverTest, countMatchesWithAndWithoutPropagation)
+{
+    std::string puzzle = kHardSolution;
+    for(unsigned int index : {0u, 1u, 9u, 10u, 30u, 31u, 40u, 50u, 60u, 70u})
+        puzzle[index] = '.';
+
+    Solver solver;
+    ASSERT_TRUE(solver.load(cellsFromString(puzzle)));
+    const uint64_t propagated = solver.count(100);
+
+    solver.setPropagationEnabled(false);
+    ASSERT_TRUE(solver.load(cellsFromString(puzzle)));
+    EXPECT_EQ(solver.count(100), propagated);
+}
+
+TEST(SolverTest, loadRejectsConflictingGivens)
+{
+    Solver solver;
+    Grid cells{};
+    cells[0] = 3;
+    cells[80] = 3;
+    EXPECT_TRUE(solver.load(cells));
+    cells[8] = 3;
+    EXPECT_FALSE(solver.load(cells));
+}
+
+TEST(SolverTest, emptyCandidateCellMakesPuzzleUnsolvable)
+{
+    // Row 0 holds 1-8 and column 8 holds a 9, so cell 8 has no candidates.
+    Grid cells{};
+    for(unsigned int index = 0; index < 8; ++index)
+        cells[index] = static_cast<uint8_t>(index + 1);
+    cells[8 + 9 * 4] = 9;
+
+    Solver solver;
+    ASSERT_TRUE(solver.load(cells));
+    EXPECT_FALSE(solver.solve());
+    EXPECT_EQ(solver.count(2), 0u);
+}
+
+TEST(SolverTest, hasSolutionExcludingFindsOnlyDifferentSolutions)
+{
+    const Grid solution = cellsFromString(kHardSolution);
+    Grid puzzle = cellsFromString(kHardPuzzle);
+
+    // The hard puzzle is unique, so no solution avoids the known digit.
+    Solver solver;
+    ASSERT_TRUE(solver.load(puzzle));
+    EXPECT_FALSE(solver.hasSolutionExcluding(1, solution[1]));
+    EXPECT_EQ(solver.count(2), 1u);
+
+    // Clearing a rectangle whose corners can swap 1 and 3 leaves two solutions.
+    Grid twoSolutions = solution;
+    for(unsigned int cell : {1u, 3u, 10u, 12u})
+        twoSolutions[cell] = 0;
+    ASSERT_TRUE(solver.load(twoSolutions));
+    EXPECT_EQ(solver.count(3), 2u);
+    EXPECT_TRUE(solver.hasSolutionExcluding(1, 1));
+    EXPECT_TRUE(solver.hasSolutionExcluding(1, 3));
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, twoSolutions);
+}
+
+TEST(SolverTest, removeAndRestoreGivenMatchReloading)
+{
+    const Grid solution = cellsFromString(kHardSolution);
+    Grid puzzle = cellsFromString(kHardPuzzle);
+
+    Solver incremental;
+    Solver reloaded;
+    ASSERT_TRUE(incremental.load(puzzle));
+    for(unsigned int cell : {0u, 6u, 8u, 10u, 40u})
+    {
+        const unsigned int value = puzzle[cell];
+        puzzle[cell] = 0;
+        incremental.removeGiven(cell);
+        ASSERT_TRUE(reloaded.load(puzzle));
+        EXPECT_EQ(incremental.count(5), reloaded.count(5));
+        EXPECT_EQ(incremental.hasSolutionExcluding(cell, solution[cell]), reloaded.hasSolutionExcluding(cell, solution[cell]));
+
+        incremental.restoreGiven(cell, value);
+        puzzle[cell] = static_cast<uint8_t>(value);
+        EXPECT_EQ(incremental.count(2), 1u);
+    }
+
+    Grid stored{};
+    incremental.store(stored);
+    EXPECT_EQ(stored, puzzle);
+}
+
+TEST(SolverTest, enumerateVisitsEverySolutionOnce)
+{
+    std::string puzzle = kHardSolution;
+    for(unsigned int index : {0u, 1u, 9u, 10u, 30u, 31u, 40u, 50u, 60u, 70u})
+        puzzle[index] = '.';
+
+    Solver solver;
+    const Grid cells = cellsFromString(puzzle);
+    ASSERT_TRUE(solver.load(cells));
+    const uint64_t expected = solver.count(100);
+
+    std::set<Grid> seen;
+    const uint64_t visited = solver.enumerate([&](const Grid& solution) {
+        for(unsigned int index = 0; index < Solver::kCells; ++index)
+            EXPECT_TRUE(cells[index] == 0 || cells[index] == solution[index]);
+        seen.insert(solution);
+        return true;
+    });
+    EXPECT_EQ(visited, expected);
+    EXPECT_EQ(seen.size(), expected);
+    EXPECT_TRUE(seen.count(cellsFromString(kHardSolution)) == 1);
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, cells);
+}
+
+TEST(SolverTest, enumerateStopsWhenTheVisitorDeclines)
+{
+    // Many solutions: the first row of the known solution and nothing else.
+    std::string puzzle(Solver::kCells, '.');
+    puzzle.replace(0, 9, kHardSolution.substr(0, 9));
+
+    Solver solver;
+    ASSERT_TRUE(solver.load(cellsFromString(puzzle)));
+    unsigned int calls = 0;
+    EXPECT_EQ(solver.enumerate([&](const Grid&) { return ++calls < 3; }), 3u);
+    EXPECT_EQ(calls, 3u);
+    // Stopping after three solutions searches exactly as far as a count to three.
+    const uint64_t enumerateNodes = solver.nodes();
+    ASSERT_TRUE(solver.load(cellsFromString(puzzle)));
+    EXPECT_EQ(solver.count(3), 3u);
+    EXPECT_EQ(solver.nodes(), enumerateNodes);
+}
+
+TEST(SolverTest, resumableSearchFindsSolutionsInEnumerationOrder)
+{
+    std::string puzzle = kHardSolution;
+    for(unsigned int index : {0u, 1u, 9u, 10u, 30u, 31u, 40u, 50u, 60u, 70u})
+        puzzle[index] = '.';
+
+    Solver solver;
+    const Grid cells = cellsFromString(puzzle);
+    ASSERT_TRUE(solver.load(cells));
+    std::vector<Grid> enumerated;
+    solver.enumerate([&](const Grid& solution) {
+        enumerated.push_back(solution);
+        return true;
+    });
+    const uint64_t enumerateNodes = solver.nodes();
+
+    ASSERT_TRUE(solver.load(cells));
+    solver.beginSearch();
+    std::vector<Grid> resumed;
+    while(solver.resume() == SearchStatus::Found)
+    {
+        Grid solution{};
+        solver.store(solution);
+        resumed.push_back(solution);
+    }
+    EXPECT_EQ(resumed, enumerated);
+    EXPECT_EQ(solver.solutionsFound(), enumerated.size());
+    EXPECT_EQ(solver.nodes(), enumerateNodes);
+    EXPECT_EQ(solver.resume(), SearchStatus::Exhausted);
+
+    Grid stored{};
+    solver.store(stored);
+    EXPECT_EQ(stored, cells);
+}
+
+TEST(SolverTest, nodeBudgetPausesWithoutRepeatingWork)
+{
+    // Without propagation the search takes enough nodes to pause often.
+    Solver solver;
+    solver.setPropagationEnabled(false);
+    const Grid cells = cellsFromString(kHardPuzzle);
+    ASSERT_TRUE(solver.load(cells));
+    solver.beginSearch();
+    ASSERT_EQ(solver.resume(), SearchStatus::Found);
+    const uint64_t unbudgetedNodes = solver.nodes();
+    ASSERT_GT(unbudgetedNodes, 1000u);
+
+    ASSERT_TRUE(solver.load(cells));
+    solver.beginSearch();
+    unsigned int pauses = 0;
+    SearchStatus status = SearchStatus::BudgetExhausted;
+    while((status = solver.resume(SearchBudget::nodes(100))) == SearchStatus::BudgetExhausted)
+        ++pauses;
+    ASSERT_EQ(status, SearchStatus::Found);
+    EXPECT_GE(pauses, unbudgetedNodes / 100 - 1);
+    EXPECT_EQ(solver.nodes(), unbudgetedNodes);
+
+    Grid solved{};
+    solver.store(solved);
+    EXPECT_EQ(solved, cellsFromString(kHardSolution));
+    EXPECT_EQ(solver.resume(), SearchStatus::Exhausted);
+}
+
+TEST(SolverTest, pausedSearchResumesOnAnotherThread)
+{
+    Solver solver;
+    solver.setPropagationEnabled(false);
+    ASSERT_TRUE(solver.load(cellsFromString(kHardPuzzle)));
+    solver.beginSearch();
+    ASSERT_EQ(solver.resume(SearchBudget::nodes(100)), SearchStatus::BudgetExhausted);
+
+    SearchBudget expired;
+    expired.deadline = SearchBudget::Clock::now();
+    EXPECT_EQ(solver.resume(expired), SearchStatus::BudgetExhausted);
+
+    CancellationToken token;
+    token.cancel();
+    SearchBudget cancelled;
+    cancelled.cancellation = &token;
+    EXPECT_EQ(solver.resume(cancelled), SearchStatus::Cancelled);
+
+    Grid solved{};
+    std::thread([&] {
+        token.reset();
+        EXPECT_EQ(solver.resume(cancelled), SearchStatus::Found);
+        solver.store(solved);
+    }).join();
+    EXPECT_EQ(solved, cellsFromString(kHardSolution));
+}
+
+TEST(SolverTest, resumableSearchOfAnInconsistentPuzzleIsExhausted)
+{
+    // Row 0 holds 1-8 and column 8 holds a 9, so cell 8 has no candidates.
+    Grid cells{};
+    for(unsigned int index = 0; index < 8; ++index)
+        cells[index] = static_cast<uint8_t>(index + 1);
+    cells[8 + 9 * 4] = 9;
+
+    Solver solver;
+    ASSERT_TRUE(solver.load(cells));
+    solver.beginSearch();
+    EXPECT_EQ(solver.resume(), SearchStatus::Exhausted);
+    EXPECT_EQ(solver.solutionsFound(), 0u);
+}
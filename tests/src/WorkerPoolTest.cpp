@@ -0,0 +1,39 @@
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "WorkerPool.h"
+
+using namespace sudoku;
+
+TEST(WorkerPoolTest, runVisitsEveryItemExactlyOnce)
+{
+    WorkerPool pool(4);
+    std::vector<std::atomic<unsigned int>> visits(1000);
+
+    pool.run(visits.size(), [&](unsigned int worker, std::size_t item) {
+        EXPECT_LT(worker, pool.size());
+        visits[item].fetch_add(1);
+    });
+
+    for(const auto& count : visits)
+        EXPECT_EQ(count.load(), 1u);
+}
+
+TEST(WorkerPoolTest, poolCanBeReusedAcrossRuns)
+{
+    WorkerPool pool(3);
+    std::atomic<unsigned int> total{0};
+
+    for(unsigned int round = 0; round < 10; ++round)
+        pool.run(50, [&](unsigned int, std::size_t) { total.fetch_add(1); });
+    pool.run(0, [&](unsigned int, std::size_t) { total.fetch_add(1); });
+
+    EXPECT_EQ(total.load(), 500u);
+}
+
+TEST(WorkerPoolTest, zeroThreadsFallsBackToOneWorker)
+{
+    WorkerPool pool(0);
+    EXPECT_EQ(pool.size(), 1u);
+}